@@ -0,0 +1,122 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+
+// --- Recursive Envelope Generators ---
+// Recurrences for the closed-form voice envelopes. Coefficients are shared by all voices and
+// rebuilt only when decay/curve or the sample rate change; each voice keeps its running state.
+// Bounds below are max abs error against the closed forms over the full parameter ranges
+// (verified by NextGenKickRender --check-envelopes).
+
+// pow(exp(-t / (decay + 1e-4)), curve) == exp(-t * curve / (decay + 1e-4))
+// One multiply per sample. Error < 1e-6 (the float closed form itself drifts by up to 3e-5).
+struct ExpDecayEnvelope {
+    void setParameters(float decaySeconds, float curve, double sampleRate) noexcept {
+        if (decaySeconds == lastDecay && curve == lastCurve && sampleRate == lastRate) return;
+        lastDecay = decaySeconds; lastCurve = curve; lastRate = sampleRate;
+        k = std::exp(-(double)curve / (((double)decaySeconds + 0.0001) * sampleRate));
+    }
+
+    static void start(double& env) noexcept { env = 1.0; }
+
+    inline float tick(double& env) const noexcept {
+        const double out = env;
+        env *= k;
+        return (float)out;
+    }
+
+private:
+    double k = 1.0;
+    float lastDecay = -1.0f, lastCurve = -1.0f;
+    double lastRate = 0.0;
+};
+
+// pow(max(0, 1 - t / (decay + 1e-4)), curve)
+// Geometric steps between exact points 1/64 of the decay apart (one pow per segment); the last
+// four segments, where the log-curvature grows, are evaluated per sample. Error < 2e-3.
+struct PowerDecayEnvelope {
+    struct State {
+        double env = 1.0, ratio = 1.0;
+        int segLeft = 0;
+    };
+
+    static constexpr int segmentsPerDecay = 64;
+    static constexpr int exactTailSegments = 4;
+
+    void setParameters(float decaySeconds, float curveVal, double sampleRate) noexcept {
+        if (decaySeconds == lastDecay && curveVal == curve && sampleRate == lastRate) return;
+        lastDecay = decaySeconds; curve = curveVal; lastRate = sampleRate;
+        invLength = 1.0 / ((double)decaySeconds + 0.0001);
+        lengthSamples = ((double)decaySeconds + 0.0001) * sampleRate;
+        segLen = std::max(1, (int)(lengthSamples / segmentsPerDecay));
+    }
+
+    static void start(State& s) noexcept { s = State(); }
+    static bool isFinished(const State& s) noexcept { return s.ratio == 0.0; }
+
+    // t = voice age in seconds at this sample
+    inline float tick(State& s, double t) const noexcept {
+        if (--s.segLeft < 0) beginSegment(s, t);
+        const double out = s.env;
+        s.env *= s.ratio;
+        return (float)out;
+    }
+
+private:
+    void beginSegment(State& s, double t) const noexcept {
+        const double u = 1.0 - t * invLength;
+        const double remaining = u * lengthSamples;
+
+        if (u <= 0.0) { s.env = 0.0; s.ratio = 0.0; s.segLeft = INT_MAX; return; }
+        if (remaining <= (double)(segLen * exactTailSegments)) { s.env = std::pow(u, (double)curve); s.ratio = 1.0; s.segLeft = 0; return; }
+
+        // The running value is carried over, so a segment costs one pow and stays continuous when parameters move
+        const double u1 = u - (double)segLen / lengthSamples;
+        s.ratio = std::pow(u1 / u, (double)curve / (double)segLen);
+        s.segLeft = segLen - 1;
+    }
+
+    double invLength = 1.0, lengthSamples = 1.0;
+    int segLen = 1;
+    float lastDecay = -1.0f, curve = -1.0f;
+    double lastRate = 0.0;
+};
+
+// 0.5 * (1 - cos(pi * n / fadeSamples)) while n / fadeSamples < 1, then 1
+// Chebyshev recurrence for the cosine (one multiply-add per sample). Error < 1e-6.
+struct RaisedCosineFade {
+    struct State {
+        double c0 = 1.0, c1 = 1.0; // cos(w * n), cos(w * (n - 1))
+        double w = -1.0;           // rate the recurrence was seeded with
+        int n = 0;
+    };
+
+    void setParameters(float fadeMs, double sampleRate) noexcept {
+        if (fadeMs == lastFadeMs && sampleRate == lastRate) return;
+        lastFadeMs = fadeMs; lastRate = sampleRate;
+        inv = 1.0f / ((fadeMs / 1000.0f) * (float)sampleRate + 0.001f);
+        w = juce::MathConstants<double>::pi * (double)inv;
+        twoCosW = 2.0 * std::cos(w);
+    }
+
+    static void start(State& s) noexcept { s = State(); }
+
+    inline float tick(State& s) const noexcept {
+        if ((float)s.n * inv >= 1.0f) return 1.0f;
+        if (s.w != w) { s.w = w; s.c0 = std::cos(w * s.n); s.c1 = std::cos(w * (s.n - 1)); }
+
+        const double out = 0.5 * (1.0 - s.c0);
+        const double next = twoCosW * s.c0 - s.c1;
+        s.c1 = s.c0; s.c0 = next;
+        ++s.n;
+        return (float)out;
+    }
+
+private:
+    float inv = 1.0f;
+    double w = 0.0, twoCosW = 2.0;
+    float lastFadeMs = -1.0f;
+    double lastRate = 0.0;
+};
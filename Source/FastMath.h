@@ -0,0 +1,142 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstring>
+
+// --- Fast Math for the saturation stage ---
+// Polynomials fitted at Chebyshev nodes (near-minimax) for the ADAA antiderivatives and their
+// direct curves. Errors are vs. double precision over |x| <= 64, the widest range the saturation
+// stage sees. Terms growing with |x| come from rounding the argument itself, which the std:: float
+// calls share, so the ADAA divided differences stay as clean as before.
+// Checked by NextGenKickRender --check-fastmath.
+namespace FastMath {
+
+// floor without the libm call (x86-64 baseline has no roundps); valid for |x| < 2^31
+inline float floor(float x) noexcept {
+    const float t = (float)(juce::int32)x;
+    return t > x ? t - 1.0f : t;
+}
+
+// 2^x, rel error < 1e-7 (x clamped to the normal float range)
+inline float exp2(float x) noexcept {
+    x = juce::jlimit(-126.0f, 127.0f, x);
+    const float fi = FastMath::floor(x);
+    const float f = x - fi;
+    float p = 2.186578479e-04f;
+    p = p * f + 1.239133183e-03f;
+    p = p * f + 9.684186310e-03f;
+    p = p * f + 5.548063020e-02f;
+    p = p * f + 2.402304544e-01f;
+    p = p * f + 6.931469328e-01f;
+    p = p * f + 1.000000003e+00f;
+
+    const juce::int32 bits = ((juce::int32)fi + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// e^x, rel error < 2e-7 + 6e-8 * |x| (rounding of x * log2(e))
+inline float exp(float x) noexcept { return exp2(x * 1.442695041f); }
+
+// log(1 + t) / t on [sqrt(0.5) - 1, sqrt(2) - 1]
+inline float log1pKernel(float t) noexcept {
+    float p = 8.533313083e-02f;
+    p = p * t - 1.426925821e-01f;
+    p = p * t + 1.497740128e-01f;
+    p = p * t - 1.657799290e-01f;
+    p = p * t + 1.995593336e-01f;
+    p = p * t - 2.500135219e-01f;
+    p = p * t + 3.333419329e-01f;
+    p = p * t - 4.999999638e-01f;
+    p = p * t + 9.999999741e-01f;
+    return p;
+}
+
+// log(1 + y) for y > -0.29, abs error < 1e-7 + 1 ulp of the result.
+// Small y never forms 1 + y, so it keeps full relative precision near zero.
+inline float log1p(float y) noexcept {
+    if (y < 0.4142135f) return y * log1pKernel(y);
+
+    // 1 + y = m * 2^e with m in [sqrt(0.5), sqrt(2))
+    const float v = 1.0f + y;
+    juce::int32 bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    int e = ((bits >> 23) & 0xff) - 127;
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    if (m > 1.4142135f) { m *= 0.5f; ++e; }
+
+    const float t = m - 1.0f;
+    return t * log1pKernel(t) + (float)e * 0.6931471806f;
+}
+
+// atan(x), abs error < 2e-7
+inline float atan(float x) noexcept {
+    const float a = std::abs(x);
+    const bool invert = a > 1.0f;
+    const float z = invert ? 1.0f / a : a;
+    const float s = z * z;
+    float p = -4.559791986e-03f;
+    p = p * s + 2.378051860e-02f;
+    p = p * s - 5.882975314e-02f;
+    p = p * s + 9.868865458e-02f;
+    p = p * s - 1.400329018e-01f;
+    p = p * s + 1.996696183e-01f;
+    p = p * s - 3.333181266e-01f;
+    p = p * s + 9.999998820e-01f;
+    p *= z;
+    if (invert) p = 1.570796327f - p;
+    return std::copysign(p, x);
+}
+
+// sin(pi * x), abs error < 2e-7
+inline float sinPi(float x) noexcept {
+    // Period 2: reduce to [-1, 1], then fold to [-0.5, 0.5] with sin(pi - a) = sin(a)
+    float r = x - 2.0f * FastMath::floor(x * 0.5f + 0.5f);
+    if (r > 0.5f) r = 1.0f - r;
+    else if (r < -0.5f) r = -1.0f - r;
+
+    const float a = r * juce::MathConstants<float>::pi;
+    const float s = a * a;
+    float p = 2.605107635e-06f;
+    p = p * s - 1.980901741e-04f;
+    p = p * s + 8.333050171e-03f;
+    p = p * s - 1.666665795e-01f;
+    p = p * s + 9.999999957e-01f;
+    return a * p;
+}
+
+// cos(pi * x), abs error < 2e-7 + pi * ulp(x) (rounding of x + 0.5)
+inline float cosPi(float x) noexcept { return sinPi(x + 0.5f); }
+
+// tanh(x), abs error < 2e-7
+inline float tanh(float x) noexcept {
+    const float e = exp(-2.0f * std::abs(x));
+    return std::copysign((1.0f - e) / (1.0f + e), x);
+}
+
+// log(cosh(x)) = |x| + log(1 + e^-2|x|) - log(2), abs error < 2e-7 + 1 ulp of |x|
+inline float logCosh(float x) noexcept {
+    const float a = std::abs(x);
+    return a + log1p(exp(-2.0f * a)) - 0.6931471806f;
+}
+
+} // namespace FastMath
+
+// Exact (std::) or fast curves behind one interface; kernels pick one at compile time
+template <bool Fast>
+struct SaturationMath {
+    static inline float tanh(float x) noexcept { return Fast ? FastMath::tanh(x) : std::tanh(x); }
+    static inline float atan(float x) noexcept { return Fast ? FastMath::atan(x) : std::atan(x); }
+    static inline float sinPi(float x) noexcept { return Fast ? FastMath::sinPi(x) : std::sin(x * juce::MathConstants<float>::pi); }
+    static inline float cosPi(float x) noexcept { return Fast ? FastMath::cosPi(x) : std::cos(x * juce::MathConstants<float>::pi); }
+    static inline float log1p(float y) noexcept { return Fast ? FastMath::log1p(y) : std::log(1.0f + y); }
+
+    static inline float logCosh(float x) noexcept {
+        if (Fast) return FastMath::logCosh(x);
+        if (std::abs(x) > 10.0f) return std::abs(x) - 0.693147f;
+        return std::log(std::cosh(x));
+    }
+};
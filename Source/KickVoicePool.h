@@ -0,0 +1,183 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include "EnvelopeGenerators.h"
+#include "StemCache.h"
+#include "LayerOscillatorCore.h"
+
+// --- Voice Stealing Policy (index matches the "voiceSteal" parameter) ---
+enum class VoiceStealMode { Oldest = 0, Quietest, SameNote };
+
+// --- Shared-coefficient TPT SVF ---
+// Same topology as juce::dsp::StateVariableTPTFilter; the integrator states live in the voice pool
+struct TPTCoeffs {
+    float g = 0.0f, R2 = 2.0f, h = 1.0f;
+
+    // No-op unless something moved, so it can be called every chunk
+    void update(float cutoff, float sampleRate, float resonance = 0.5f) noexcept {
+        if (cutoff == lastCutoff && sampleRate == lastRate && resonance == lastResonance) return;
+        lastCutoff = cutoff; lastRate = sampleRate; lastResonance = resonance;
+        g = (float)std::tan(juce::MathConstants<double>::pi * (double)cutoff / (double)sampleRate);
+        R2 = 1.0f / resonance;
+        h = 1.0f / (1.0f + R2 * g + g * g);
+    }
+
+    inline float processLowpass(float x, float& s1, float& s2) const noexcept {
+        const float yHP = h * (x - s1 * (g + R2) - s2);
+        const float yBP = yHP * g + s1; s1 = yHP * g + yBP;
+        const float yLP = yBP * g + s2; s2 = yBP * g + yLP;
+        return yLP;
+    }
+
+    inline float processHighpass(float x, float& s1, float& s2) const noexcept {
+        const float yHP = h * (x - s1 * (g + R2) - s2);
+        const float yBP = yHP * g + s1; s1 = yHP * g + yBP;
+        const float yLP = yBP * g + s2; s2 = yBP * g + yLP;
+        return yHP;
+    }
+
+private:
+    float lastCutoff = -1.0f, lastRate = 0.0f, lastResonance = 0.0f;
+};
+
+// --- Polyphonic Voice Pool (structure-of-arrays) ---
+// Active voices are kept packed in [0, numActive), so every per-voice stage is a plain
+// contiguous loop. Storage is sized in prepare() and never reallocated on the audio thread.
+// A stolen voice is not cut: it fades out over stealFadeSeconds in a spare slot while the new
+// note starts in another, so the pool holds up to maxVoices sounding plus maxVoices fading.
+struct KickVoicePool {
+    static constexpr int maxVoices = 16;
+    static constexpr int maxSlots = 2 * maxVoices;
+    static constexpr double stealFadeSeconds = 0.005; // as short as the sub's default anti-click
+
+    int numActive = 0;
+
+    // Layer phases (fixed point, four lanes per voice) and the per-sample lane scratch
+    LayerOscillatorCore osc;
+    static_assert(maxSlots * LayerOscillatorCore::lanesPerVoice <= LayerOscillatorCore::maxLanes, "too few oscillator lanes");
+
+    std::vector<double> time;
+    std::vector<float> subBaseHz, level;
+    std::vector<float> stealGain, stealStep; // output gain; a step above 0 ramps a stolen voice to silence
+    std::vector<int> note;
+    std::vector<juce::uint32> serial;
+
+    // Running envelope states (coefficients live in the processor, shared by all voices)
+    std::vector<PowerDecayEnvelope::State> envAtk;
+    std::vector<double> envPitch, envBody, envSub;
+    std::vector<RaisedCosineFade::State> subFade;
+
+    // TPT integrator states per layer filter
+    std::vector<float> atkHP1, atkHP2, atkLP1, atkLP2, bodyLP1, bodyLP2;
+
+    // Cached stems per layer (nullptr: the layer is synthesized live) and the voice's stem read position.
+    // Inactive slots hold no stem, so every reference the pool drops is released exactly once.
+    std::array<std::vector<const CachedStem*>, numStemLayers> stems;
+    std::vector<int> stemPos;
+
+    static int polyphonyFromChoice(int index) noexcept {
+        static constexpr int counts[] = { 1, 2, 4, 8, 16 };
+        return counts[juce::jlimit(0, 4, index)];
+    }
+
+    void prepare(double sampleRate) {
+        for (auto* v : { &time, &envPitch, &envBody, &envSub }) v->assign(maxSlots, 0.0);
+        for (auto* v : { &subBaseHz, &level, &stealStep, &atkHP1, &atkHP2, &atkLP1, &atkLP2, &bodyLP1, &bodyLP2 }) v->assign(maxSlots, 0.0f);
+        stealGain.assign(maxSlots, 1.0f);
+        stealFadeStep = (float)(1.0 / juce::jmax(1.0, stealFadeSeconds * sampleRate));
+        osc = LayerOscillatorCore();
+        note.assign(maxSlots, 0);
+        serial.assign(maxSlots, 0);
+        envAtk.assign(maxSlots, {});
+        subFade.assign(maxSlots, {});
+        for (int v = 0; v < (int)stemPos.size(); ++v) releaseStems(v);
+        for (auto& s : stems) s.assign(maxSlots, nullptr);
+        stemPos.assign(maxSlots, 0);
+        reset();
+    }
+
+    void reset() noexcept {
+        for (int v = 0; v < numActive; ++v) releaseStems(v);
+        numActive = 0;
+        nextSerial = 0;
+    }
+
+    bool isFadingOut(int v) const noexcept { return stealStep[v] > 0.0f; }
+
+    // Returns the slot for a new note. When the pool is full (or, in Same Note mode, the note is
+    // already sounding) the victim fades out and the note gets a free slot; only when every spare
+    // slot is still fading is the victim restarted in place.
+    int allocate(int newNote, int polyphony, VoiceStealMode mode) noexcept {
+        int victim = -1, sounding = 0;
+        for (int v = 0; v < numActive; ++v) {
+            if (isFadingOut(v)) continue;
+            ++sounding;
+            if (mode == VoiceStealMode::SameNote && note[v] == newNote) victim = v;
+        }
+
+        if (victim < 0) {
+            if (sounding < juce::jlimit(1, maxVoices, polyphony)) return numActive++;
+            for (int v = 0; v < numActive; ++v) {
+                if (isFadingOut(v)) continue;
+                if (victim < 0) victim = v;
+                else if (mode == VoiceStealMode::Quietest) { if (level[v] < level[victim]) victim = v; }
+                else if ((juce::int32)(serial[v] - serial[victim]) < 0) victim = v; // oldest, wrap-safe
+            }
+        }
+
+        if (numActive == maxSlots) return victim;
+        stealStep[victim] = stealFadeStep;
+        return numActive++;
+    }
+
+    juce::uint32& phase(int v, int lane) noexcept { return osc.phase[(size_t)LayerOscillatorCore::index(v, lane)]; }
+
+    void start(int v, int midiNote, juce::uint32 startPhase, juce::uint32 subStartPhase, float subHz) noexcept {
+        phase(v, LayerOscillatorCore::laneAtk) = phase(v, LayerOscillatorCore::laneBody) = startPhase;
+        phase(v, LayerOscillatorCore::laneSub) = subStartPhase;
+        time[v] = 0.0;
+        subBaseHz[v] = subHz;
+        level[v] = 1.0f;
+        stealGain[v] = 1.0f;
+        stealStep[v] = 0.0f;
+        note[v] = midiNote;
+        serial[v] = nextSerial++;
+        PowerDecayEnvelope::start(envAtk[v]);
+        ExpDecayEnvelope::start(envPitch[v]); ExpDecayEnvelope::start(envBody[v]); ExpDecayEnvelope::start(envSub[v]);
+        RaisedCosineFade::start(subFade[v]);
+        atkHP1[v] = atkHP2[v] = atkLP1[v] = atkLP2[v] = bodyLP1[v] = bodyLP2[v] = 0.0f;
+        releaseStems(v);
+        stemPos[v] = 0;
+    }
+
+    bool hasStems(int v) const noexcept { return stems[layerAtk][v] != nullptr || stems[layerBody][v] != nullptr || stems[layerSub][v] != nullptr; }
+
+    void releaseStems(int v) noexcept {
+        for (auto& s : stems) { CachedStem::release(s[v]); s[v] = nullptr; }
+    }
+
+    // Frees slot v by moving the last active voice into it
+    void remove(int v) noexcept {
+        const int last = --numActive;
+        releaseStems(v);
+        if (v == last) return;
+
+        for (int lane = 0; lane < LayerOscillatorCore::lanesPerVoice; ++lane) phase(v, lane) = phase(last, lane);
+        time[v] = time[last];
+        subBaseHz[v] = subBaseHz[last]; level[v] = level[last];
+        stealGain[v] = stealGain[last]; stealStep[v] = stealStep[last];
+        note[v] = note[last]; serial[v] = serial[last];
+        envAtk[v] = envAtk[last]; envPitch[v] = envPitch[last]; envBody[v] = envBody[last]; envSub[v] = envSub[last]; subFade[v] = subFade[last];
+        atkHP1[v] = atkHP1[last]; atkHP2[v] = atkHP2[last]; atkLP1[v] = atkLP1[last]; atkLP2[v] = atkLP2[last];
+        bodyLP1[v] = bodyLP1[last]; bodyLP2[v] = bodyLP2[last];
+        for (auto& s : stems) { s[v] = s[last]; s[last] = nullptr; }
+        stemPos[v] = stemPos[last];
+    }
+
+private:
+    juce::uint32 nextSerial = 0;
+    float stealFadeStep = 1.0f;
+};
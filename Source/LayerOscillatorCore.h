@@ -0,0 +1,80 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+// --- Layer-packed Oscillator Core ---
+// Every voice owns four lanes: attack, body, sub and a spare. Phases are 32-bit fixed point
+// (2^32 = one cycle), so they wrap for free. One pass per sample evaluates the sine of every lane,
+// scales it by the lane gain and advances the phases, a SIMDRegister at a time: one voice per
+// SSE2/NEON register, two per AVX2 one. A layer that is not a sine (or plays a stem) gets gain 0
+// and is shaped by the scalar code from the same phase.
+struct LayerOscillatorCore {
+    enum Lane { laneAtk, laneBody, laneSub, lanesPerVoice = 4 };
+    static constexpr int maxLanes = 128; // 16 voices plus 16 stolen ones fading out
+
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int vecSize = (int)Vec::SIMDNumElements;
+    static_assert(maxLanes % vecSize == 0, "lanes must fill whole registers");
+
+    static int index(int voice, int lane) noexcept { return voice * lanesPerVoice + lane; }
+
+    // What SIMDRegister was compiled for (JUCE uses AVX2 when __AVX2__ is defined)
+    static const char* instructionSet() noexcept {
+#if defined(__AVX2__)
+        return "AVX2";
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        return "SSE2";
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    // Fixed-point phase of a position in cycles (any real value) and the step for dt cycles per sample
+    static juce::uint32 phaseFromCycles(double cycles) noexcept {
+        return (juce::uint32)(juce::int64)std::llround((cycles - std::floor(cycles)) * 4294967296.0);
+    }
+    static juce::uint32 increment(double cyclesPerSample) noexcept { return (juce::uint32)(juce::int64)(cyclesPerSample * 4294967296.0 + 0.5); } // 0 <= dt < 1
+    static double toCycles(juce::uint32 phase) noexcept { return (double)phase * (1.0 / 4294967296.0); }
+
+    // -sin(2 pi phase), the polarity the sine layers have always had; the same arithmetic as process()
+    static float sine(juce::uint32 phase) noexcept { return ultraPureSine(Vec::expand(toSignedUnit(phase + halfCycle))).get(0); }
+
+    // One sample for the first numLanes lanes: out = gain * sine(phase), then phase += inc
+    void process(int numLanes) noexcept {
+        const int n = (numLanes + vecSize - 1) / vecSize * vecSize;
+        for (int k = 0; k < n; ++k) x[(size_t)k] = toSignedUnit(phase[(size_t)k] + halfCycle);
+        for (int k = 0; k < n; k += vecSize)
+            (ultraPureSine(Vec::fromRawArray(x.data() + k)) * Vec::fromRawArray(gain.data() + k)).copyToRawArray(out.data() + k);
+        for (int k = 0; k < n; ++k) phase[(size_t)k] += inc[(size_t)k];
+    }
+
+    // Voice state: phases. Written every sample before process(): inc and gain (the spare lane keeps 0).
+    alignas(Vec::SIMDRegisterSize) std::array<juce::uint32, maxLanes> phase{};
+    alignas(Vec::SIMDRegisterSize) std::array<juce::uint32, maxLanes> inc{};
+    alignas(Vec::SIMDRegisterSize) std::array<float, maxLanes> gain{};
+    alignas(Vec::SIMDRegisterSize) std::array<float, maxLanes> out{};
+
+private:
+    static constexpr juce::uint32 halfCycle = 0x80000000u;
+
+    // The phase as x in [-1, 1), with angle pi * x; offset by halfCycle it is 2 * phase - 1
+    static inline float toSignedUnit(juce::uint32 phase) noexcept { return (float)(juce::int32)phase * (1.0f / 2147483648.0f); }
+
+    // generateUltraPureSine's polynomial and coefficients at pi * (2 * phase - 1), in float: the sine
+    // layers keep the values (and the truncation error, up to 8e-4 near phase 0) they always had
+    static inline Vec ultraPureSine(Vec x) noexcept {
+        const Vec a = x * juce::MathConstants<float>::pi;
+        const Vec s = a * a;
+        Vec p = Vec::expand(0.0000027557f) - s * Vec::expand(0.0000000209f);
+        p = Vec::expand(0.0001984127f) - s * p;
+        p = Vec::expand(0.0083333333f) - s * p;
+        p = Vec::expand(0.1666666667f) - s * p;
+        p = Vec::expand(1.0f) - s * p;
+        return a * p;
+    }
+
+    alignas(Vec::SIMDRegisterSize) std::array<float, maxLanes> x{};
+};
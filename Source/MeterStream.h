@@ -0,0 +1,140 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// --- Output Metering Stream ---
+// The audio thread summarizes its output into frames instead of handing over raw samples. A frame
+// holds the stereo peak and mean square and the min/max of the mono mix. Level 0 frames span a
+// power-of-two sample count picked from the sample rate (about 1/12000 s: 4 samples at 48 kHz,
+// 16 at 192 kHz), and each further level merges levelRatio frames of the one below. Frame rates,
+// and so what the editor reads per tick, stay about the same whatever the sample rate.
+struct MeterFrame {
+    float peakL = 0.0f, peakR = 0.0f;
+    float meanSquareL = 0.0f, meanSquareR = 0.0f;
+    float min = 0.0f, max = 0.0f; // of (L + R) / 2
+
+    float peak() const noexcept { return std::max(peakL, peakR); }
+    float meanSquare() const noexcept { return 0.5f * (meanSquareL + meanSquareR); }
+};
+
+class MeterStream {
+public:
+    enum Level { scopeLevel, meterLevel, numLevels }; // ~1/12000 s and ~1/375 s per frame
+    static constexpr double scopeFramesPerSecond = 12000.0;
+    static constexpr int levelRatio = 32;
+    static constexpr int fifoSize = 4096; // per level: a third of a second of scope frames
+
+    MeterStream() {
+        for (auto& b : buffers) b.resize((size_t)fifoSize);
+        reset();
+    }
+
+    // Before playback (not the audio thread). Pending frames stay readable.
+    void prepare(double sampleRate) {
+        frameLength = 1;
+        while ((double)frameLength * scopeFramesPerSecond < sampleRate * 0.75) frameLength <<= 1;
+        frameSeconds.store((double)frameLength / sampleRate);
+        reset();
+    }
+
+    // Audio thread: adds n output samples; a full FIFO drops frames rather than waiting
+    void push(const float* left, const float* right, int n) noexcept {
+        auto& f = accumulators[0];
+        for (int i = 0; i < n; ++i) {
+            const float l = left[i], r = right[i], mono = (l + r) * 0.5f;
+            f.peakL = std::max(f.peakL, std::abs(l));
+            f.peakR = std::max(f.peakR, std::abs(r));
+            f.meanSquareL += l * l;
+            f.meanSquareR += r * r;
+            f.min = std::min(f.min, mono);
+            f.max = std::max(f.max, mono);
+            if (++counts[0] == frameLength) finishFrame(0, frameLength);
+        }
+    }
+
+    // Audio thread: adds n samples of silence, the same frames push() would make from zeros
+    void pushSilence(int n) noexcept {
+        auto& f = accumulators[0];
+        while (n > 0) {
+            const int take = std::min(n, frameLength - counts[0]);
+            f.min = std::min(f.min, 0.0f);
+            f.max = std::max(f.max, 0.0f);
+            counts[0] += take;
+            n -= take;
+            if (counts[0] == frameLength) finishFrame(0, frameLength);
+        }
+    }
+
+    // Reader: copies up to maxFrames of the oldest frames of one level, returns how many
+    int read(int level, MeterFrame* dest, int maxFrames) noexcept {
+        auto& fifo = fifos[(size_t)level];
+        const auto& buffer = buffers[(size_t)level];
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+        std::copy_n(buffer.begin() + start1, size1, dest);
+        std::copy_n(buffer.begin() + start2, size2, dest + size1);
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    // Seconds covered by one frame of the level
+    double getFrameSeconds(int level) const noexcept {
+        return frameSeconds.load() * std::pow((double)levelRatio, (double)level);
+    }
+
+private:
+    void reset() noexcept {
+        for (auto& f : accumulators) clear(f);
+        counts.fill(0);
+    }
+
+    static void clear(MeterFrame& f) noexcept {
+        f = MeterFrame();
+        f.min = std::numeric_limits<float>::max();
+        f.max = std::numeric_limits<float>::lowest();
+    }
+
+    // Normalizes the level's frame, publishes it and merges it into the level above
+    void finishFrame(int level, int length) noexcept {
+        auto& f = accumulators[(size_t)level];
+        f.meanSquareL /= (float)length;
+        f.meanSquareR /= (float)length;
+
+        int start1, size1, start2, size2;
+        fifos[(size_t)level].prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 > 0) {
+            buffers[(size_t)level][(size_t)(size1 > 0 ? start1 : start2)] = f;
+            fifos[(size_t)level].finishedWrite(1);
+        }
+
+        if (level + 1 < numLevels) {
+            auto& up = accumulators[(size_t)level + 1];
+            up.peakL = std::max(up.peakL, f.peakL);
+            up.peakR = std::max(up.peakR, f.peakR);
+            up.meanSquareL += f.meanSquareL;
+            up.meanSquareR += f.meanSquareR;
+            up.min = std::min(up.min, f.min);
+            up.max = std::max(up.max, f.max);
+            if (++counts[(size_t)level + 1] == levelRatio) finishFrame(level + 1, levelRatio);
+        }
+
+        clear(f);
+        counts[(size_t)level] = 0;
+    }
+
+    // Audio thread only
+    std::array<MeterFrame, numLevels> accumulators;
+    std::array<int, numLevels> counts{};
+    int frameLength = 1;
+
+    std::atomic<double> frameSeconds{ 1.0 / scopeFramesPerSecond };
+    std::array<juce::AbstractFifo, numLevels> fifos{ { juce::AbstractFifo(fifoSize), juce::AbstractFifo(fifoSize) } };
+    std::array<std::vector<MeterFrame>, numLevels> buffers;
+
+    JUCE_DECLARE_NON_COPYABLE(MeterStream)
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <algorithm>
+
+// --- Attack Noise ---
+// White, pink and brown noise for atkWave 0..2, a block at a time. Four xorshift32 lanes step side
+// by side (one SIMD register), so the generator loop vectorizes. White noise is approximately
+// Gaussian: the sum of four 16-bit uniforms (Irwin-Hall) instead of Box-Muller's log/sqrt/sin/cos.
+// Pink and brown run their filters over a block of uniforms. The voice loop owns one generator;
+// the preview renderer runs its own, so it never advances the live sequence.
+struct NoiseGenerator {
+    static constexpr int numLanes = 4;
+
+    NoiseGenerator() : NoiseGenerator(juce::Random().nextInt64()) {}
+
+    explicit NoiseGenerator(juce::int64 seed) {
+        // splitmix64 spreads the seed over the lanes; a xorshift state must not be zero
+        auto z = (juce::uint64)seed;
+        for (auto& s : lanes) {
+            z += 0x9e3779b97f4a7c15ull;
+            auto x = z;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            s = (juce::uint32)(x ^ (x >> 31)) | 1u;
+        }
+    }
+
+    // type = atkWave (0: white, 1: pink, 2: brown)
+    void fill(int type, float* dest, int numSamples) noexcept {
+        if (type == 0) { fillWhite(dest, numSamples); return; }
+
+        fillUniform(dest, numSamples);
+        if (type == 1) filterPink(dest, numSamples);
+        else filterBrown(dest, numSamples);
+    }
+
+private:
+    using Words = std::array<juce::uint32, numLanes>;
+
+    inline void step(Words& out) noexcept {
+        for (int j = 0; j < numLanes; ++j) {
+            auto x = lanes[(size_t)j];
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            lanes[(size_t)j] = x;
+            out[(size_t)j] = x;
+        }
+    }
+
+    // Full groups of numLanes samples; a partial last group discards the lanes it does not need
+    template <typename Group>
+    inline void forEachGroup(float* dest, int numSamples, Group&& group) noexcept {
+        int i = 0;
+        for (; i + numLanes <= numSamples; i += numLanes) group(dest + i);
+        if (i < numSamples) {
+            std::array<float, numLanes> tail;
+            group(tail.data());
+            std::copy_n(tail.begin(), numSamples - i, dest + i);
+        }
+    }
+
+    // Four 16-bit uniforms per sample: mean 2 * 65535, sd 65536 / sqrt(3); scaled to the old
+    // Box-Muller level (sd 0.4)
+    void fillWhite(float* dest, int numSamples) noexcept {
+        constexpr float scale = 1.7320508f * 0.4f / 65536.0f;
+        forEachGroup(dest, numSamples, [this](float* out) {
+            Words a, b;
+            step(a); step(b);
+            for (int j = 0; j < numLanes; ++j) {
+                const auto sum = (a[(size_t)j] & 0xffffu) + (a[(size_t)j] >> 16) + (b[(size_t)j] & 0xffffu) + (b[(size_t)j] >> 16);
+                out[j] = ((float)(juce::int32)sum - 131070.0f) * scale;
+            }
+        });
+    }
+
+    // Uniform in [-1, 1)
+    void fillUniform(float* dest, int numSamples) noexcept {
+        forEachGroup(dest, numSamples, [this](float* out) {
+            Words a;
+            step(a);
+            for (int j = 0; j < numLanes; ++j) out[j] = (float)(juce::int32)a[(size_t)j] * (1.0f / 2147483648.0f);
+        });
+    }
+
+    // Paul Kellet's refined pink filter, in place over uniform white
+    void filterPink(float* x, int numSamples) noexcept {
+        for (int i = 0; i < numSamples; ++i) {
+            const float w = x[i];
+            b0 = 0.99886f * b0 + w * 0.0555179f; b1 = 0.99332f * b1 + w * 0.0750312f; b2 = 0.96900f * b2 + w * 0.1538520f;
+            b3 = 0.86650f * b3 + w * 0.3104856f; b4 = 0.55000f * b4 + w * 0.5329522f; b5 = -0.7616f * b5 + w * 0.0168980f;
+            x[i] = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * 0.5362f) * 0.11f; b6 = w * 0.11592f;
+        }
+    }
+
+    void filterBrown(float* x, int numSamples) noexcept {
+        for (int i = 0; i < numSamples; ++i) {
+            lastBrown = (lastBrown + 0.02f * x[i]) / 1.02f;
+            x[i] = lastBrown * 3.5f;
+        }
+    }
+
+    Words lanes{};
+    float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0, lastBrown = 0;
+};
@@ -0,0 +1,163 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// --- Parameter Table ---
+// Every automatable parameter in one compile-time table: ID, host name, range, default, how the
+// processor smooths it and whether presets store it. ParamId indexes it everywhere; the parameter
+// layout, the processor's atomics, PresetData and the editor attachments are all built from it, so
+// each ID is spelled once. Table order is the layout order, i.e. the hosts' parameter indices:
+// append new parameters at the end.
+enum ParamId {
+    pAtkWave, pAtkDecay, pAtkCurve, pAtkTone, pAtkLevel, pAtkPan, pAtkPitch, pAtkHPF, pAtkPulseWidth,
+    pBodyWave, pPStart, pPEnd, pPDecay, pPGlide, pPCurve, pBodyDecay, pBodyCurve, pBodyLevel, pBodyPan, pBesselRatio, pBodyFilter,
+    pSubNote, pSubFine, pSubTrack, pSubDecay, pSubCurve, pSubLevel, pSubPhase, pSubAntiClick, pSubPan,
+    pMasterDrive, pSatType, pMasterOut, pMasterWidth, pMasterRelease, pMasterPhase, pLimThreshold, pLimLookahead, pMasterLPF,
+    pOsMode, pPolyphony, pVoiceSteal, pLimTruePeak, pLayerOutMode,
+    numParams
+};
+
+enum class ParamType { Float, Choice, Bool };
+
+// How the audio thread reads a parameter
+enum class ParamSmoothing {
+    Block,  // once per processBlock: choices, switches and settings that change latency
+    Span,   // ramped per span for the voice loop (SmoothedBlockParam)
+    Sample  // ramped per sample in the output stage, or its target read at note-on (LinearSmoothedValue)
+};
+
+struct ParamSpec {
+    const char* id;
+    const char* name;
+    ParamType type;
+    float min, max, def;
+    float interval, skew;       // NormalisableRange; interval 0 is continuous
+    const char* const* choices; // ParamType::Choice
+    int numChoices;
+    ParamSmoothing smoothing;
+    double smoothingSeconds;
+    bool inPreset;
+};
+
+namespace ParamChoices {
+    inline constexpr const char* atkWave[] = { "White", "Pink", "Brown", "Square", "Saw", "Triangle", "Pulse", "Ultra Sine" };
+    inline constexpr const char* bodyWave[] = { "Ultra Sine", "Bessel", "Saw", "Square", "Triangle" };
+    inline constexpr const char* satType[] = { "Soft Tanh", "Hard Clip", "Triode", "Tape", "Transformer", "JFET", "BJT", "Wavefold", "Bitcrush", "Exciter", "Cubic" };
+    inline constexpr const char* osMode[] = { "Off", "2x (Standard)", "4x (High)", "8x (Ultra)" };
+    inline constexpr const char* polyphony[] = { "1", "2", "4", "8", "16" };
+    inline constexpr const char* voiceSteal[] = { "Oldest", "Quietest", "Same Note" };
+    inline constexpr const char* layerOutMode[] = { "Pre Master", "Post Master" };
+}
+
+namespace ParamTableDetail {
+    inline constexpr double smoothingSeconds = 0.02;
+    using S = ParamSmoothing;
+
+    constexpr ParamSpec floatParam(const char* id, const char* name, float min, float max, float def, S smoothing,
+        bool inPreset = true, float interval = 0.0f, float skew = 1.0f) {
+        return { id, name, ParamType::Float, min, max, def, interval, skew, nullptr, 0,
+                 smoothing, smoothing == S::Block ? 0.0 : smoothingSeconds, inPreset };
+    }
+
+    template <size_t N>
+    constexpr ParamSpec choiceParam(const char* id, const char* name, const char* const (&choices)[N], int def, bool inPreset = true) {
+        return { id, name, ParamType::Choice, 0.0f, (float)(N - 1), (float)def, 1.0f, 1.0f, choices, (int)N, S::Block, 0.0, inPreset };
+    }
+
+    constexpr ParamSpec boolParam(const char* id, const char* name, bool def, bool inPreset = true) {
+        return { id, name, ParamType::Bool, 0.0f, 1.0f, def ? 1.0f : 0.0f, 1.0f, 1.0f, nullptr, 0, S::Block, 0.0, inPreset };
+    }
+}
+
+inline constexpr std::array<ParamSpec, numParams> paramTable = [] {
+    using namespace ParamTableDetail;
+    return std::array<ParamSpec, numParams>{ {
+        choiceParam("atkWave", "Atk Waveform", ParamChoices::atkWave, 0),
+        floatParam("atkDecay", "Atk Decay", 0.001f, 0.2f, 0.01f, S::Span),
+        floatParam("atkCurve", "Atk Decay Curve", 0.1f, 10.0f, 2.0f, S::Span),
+        floatParam("atkTone", "Atk Tone (Hi-Cut)", 100.0f, 20000.0f, 20000.0f, S::Span),
+        floatParam("atkLevel", "Atk Level", 0.0f, 1.0f, 0.4f, S::Span),
+        floatParam("atkPan", "Atk Panning", -1.0f, 1.0f, 0.0f, S::Span),
+        floatParam("atkPitch", "Atk Click Freq", 100.0f, 15000.0f, 3000.0f, S::Span, true, 1.0f, 0.25f),
+        floatParam("atkHPF", "Atk HighPass", 20.0f, 2000.0f, 200.0f, S::Span),
+        floatParam("atkPulseWidth", "Atk Pulse Width", 0.01f, 0.99f, 0.5f, S::Span),
+
+        choiceParam("bodyWave", "Body Waveform", ParamChoices::bodyWave, 0),
+        floatParam("pStart", "Body Pitch Start", 100.0f, 2000.0f, 350.0f, S::Span),
+        floatParam("pEnd", "Body Pitch End", 20.0f, 150.0f, 43.6f, S::Span),
+        floatParam("pDecay", "Body Pitch Decay", 0.01f, 0.5f, 0.07f, S::Span),
+        floatParam("pGlide", "Von Karman Tension", 0.0f, 5.0f, 0.8f, S::Span),
+        floatParam("pCurve", "Body Pitch Curve", 0.1f, 5.0f, 1.0f, S::Span),
+        floatParam("bodyDecay", "Body Amp Decay", 0.05f, 1.5f, 0.35f, S::Span),
+        floatParam("bodyCurve", "Body Amp Curve", 0.1f, 5.0f, 1.0f, S::Span),
+        floatParam("bodyLevel", "Body Level", 0.0f, 1.0f, 0.75f, S::Span),
+        floatParam("bodyPan", "Body Panning", -1.0f, 1.0f, 0.0f, S::Span),
+        floatParam("besselRatio", "Bessel Ratio", 1.0f, 3.0f, 1.593f, S::Span),
+        floatParam("bodyFilter", "Body LowPass", 100.0f, 12000.0f, 5000.0f, S::Span),
+
+        floatParam("subNote", "Sub Note (MIDI)", 24.0f, 48.0f, 29.0f, S::Span),
+        floatParam("subFine", "Sub Fine Tune (Hz)", -10.0f, 10.0f, 0.0f, S::Span),
+        boolParam("subTrack", "Key Tracking", false),
+        floatParam("subDecay", "Sub Amp Decay", 0.10f, 5.0f, 0.25f, S::Span),
+        floatParam("subCurve", "Sub Decay Curve", 3.0f, 10.0f, 4.0f, S::Span),
+        floatParam("subLevel", "Sub Level", 0.0f, 1.0f, 0.65f, S::Span),
+        floatParam("subPhase", "Sub Phase Offset", 0.0f, 360.0f, 0.0f, S::Sample),
+        floatParam("subAntiClick", "Sub Anti-Click (ms)", 0.10f, 50.0f, 5.0f, S::Span),
+        floatParam("subPan", "Sub Panning", -1.0f, 1.0f, 0.0f, S::Span),
+
+        floatParam("masterDrive", "Master Drive", 1.0f, 25.0f, 1.0f, S::Span),
+        choiceParam("satType", "Saturation Mode", ParamChoices::satType, 0),
+        floatParam("masterOut", "Final Volume", 0.0f, 1.0f, 0.7f, S::Span),
+        floatParam("masterWidth", "Stereo Width", 0.0f, 1.0f, 1.0f, S::Sample),
+        floatParam("masterRelease", "Note Safety Tail", 3.00f, 20.0f, 5.0f, S::Span),
+        floatParam("masterPhase", "Global Phase Reset", 0.0f, 360.0f, 0.0f, S::Sample),
+        floatParam("limThreshold", "Limiter Threshold (dB)", -12.0f, 0.0f, 0.0f, S::Span),
+        floatParam("limLookahead", "Limiter Look-ahead (ms)", 0.0f, 5.0f, 1.0f, S::Block),
+        floatParam("masterLPF", "Master LowPass", 60.0f, 20000.0f, 20000.0f, S::Span),
+
+        choiceParam("osMode", "Oversampling", ParamChoices::osMode, 1),
+        choiceParam("polyphony", "Voices", ParamChoices::polyphony, 0, false),
+        choiceParam("voiceSteal", "Voice Stealing", ParamChoices::voiceSteal, 0, false),
+        boolParam("limTruePeak", "Limiter True Peak", false, false),
+        choiceParam("layerOutMode", "Layer Outputs", ParamChoices::layerOutMode, 0, false)
+    } };
+}();
+
+constexpr const ParamSpec& paramSpec(ParamId p) noexcept { return paramTable[(size_t)p]; }
+
+// Defaults of every parameter, the starting point of a preset
+constexpr std::array<float, numParams> paramDefaults() noexcept {
+    std::array<float, numParams> values{};
+    for (size_t p = 0; p < values.size(); ++p) values[p] = paramTable[p].def;
+    return values;
+}
+
+constexpr int countParams(ParamSmoothing smoothing) noexcept {
+    int n = 0;
+    for (const auto& spec : paramTable) n += spec.smoothing == smoothing ? 1 : 0;
+    return n;
+}
+
+// --- Compile-time checks: every entry filled in, IDs unique ---
+namespace ParamTableDetail {
+    constexpr bool sameString(const char* a, const char* b) noexcept {
+        while (*a != 0 && *a == *b) { ++a; ++b; }
+        return *a == *b;
+    }
+
+    constexpr bool tableComplete() noexcept {
+        for (const auto& spec : paramTable)
+            if (spec.id == nullptr || spec.name == nullptr) return false;
+        return true;
+    }
+
+    constexpr bool idsUnique() noexcept {
+        for (size_t a = 0; a < paramTable.size(); ++a)
+            for (size_t b = a + 1; b < paramTable.size(); ++b)
+                if (sameString(paramTable[a].id, paramTable[b].id)) return false;
+        return true;
+    }
+}
+
+static_assert(ParamTableDetail::tableComplete(), "paramTable is missing entries");
+static_assert(ParamTableDetail::idsUnique(), "paramTable IDs must be unique");
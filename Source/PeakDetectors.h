@@ -0,0 +1,88 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+// --- Peak Detectors for the lookahead limiter ---
+
+// Maximum over the last windowLength pushed values (monotonic deque). The deque holds the
+// window's candidates in decreasing order; a new value evicts every smaller one before it is
+// appended, so each value is pushed and popped once: O(1) amortized, whatever the window length.
+// Shrinking the window takes effect at once; a grown one is exact again after windowLength pushes.
+struct SlidingMaxWindow {
+    void prepare(int maxWindowLength) {
+        int capacity = 1;
+        while (capacity < maxWindowLength + 1) capacity <<= 1;
+        values.assign((size_t)capacity, 0.0f);
+        times.assign((size_t)capacity, 0);
+        mask = (unsigned)capacity - 1;
+        reset();
+    }
+
+    void reset() noexcept { head = tail = now = 0; }
+
+    // Adds v and returns the maximum of the last windowLength values, v included (windowLength >= 1)
+    inline float push(float v, int windowLength) noexcept {
+        while (tail != head && values[(tail - 1) & mask] <= v) --tail;
+        values[tail & mask] = v;
+        times[tail & mask] = now;
+        ++tail;
+
+        while (now - times[head & mask] >= (unsigned)windowLength) ++head;
+        ++now;
+        return values[head & mask];
+    }
+
+private:
+    std::vector<float> values;
+    std::vector<unsigned> times;
+    unsigned head = 0, tail = 0, now = 0, mask = 0;
+};
+
+// 4x oversampled (inter-sample) peak, as in ITU-R BS.1770: three points between each pair of
+// samples from a 48-tap Hann-windowed sinc, split into 12-tap phases. The result covers the
+// interval [n - delay - 1, n - delay], so the audio path has to lag the detector by `delay`.
+struct TruePeakInterpolator {
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int delay = tapsPerPhase / 2 - 1;
+
+    TruePeakInterpolator() {
+        const double pi = juce::MathConstants<double>::pi;
+        const double halfSpan = (double)tapsPerPhase / 2.0;
+        for (int p = 0; p < oversampling - 1; ++p) {
+            const double frac = (double)(p + 1) / (double)oversampling;
+            double sum = 0.0;
+            std::array<double, tapsPerPhase> h{};
+            for (int k = 0; k < tapsPerPhase; ++k) {
+                // Distance from the interpolated point to the sample k steps back
+                const double u = (double)(k - delay - 1) + frac;
+                const double sinc = std::sin(pi * u) / (pi * u);
+                h[(size_t)k] = sinc * 0.5 * (1.0 + std::cos(pi * u / halfSpan));
+                sum += h[(size_t)k];
+            }
+            // Unity DC gain per phase
+            for (int k = 0; k < tapsPerPhase; ++k) coeffs[(size_t)k][(size_t)p] = (float)(h[(size_t)k] / sum);
+        }
+    }
+
+    // x(k) returns the sample k steps back (x(0) = newest)
+    template <typename History>
+    inline float process(const History& x) const noexcept {
+        // All phases in one pass over the history (tap-major coefficients)
+        float y0 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+        for (int k = 0; k < tapsPerPhase; ++k) {
+            const float s = x(k);
+            const auto& c = coeffs[(size_t)k];
+            y0 += c[0] * s; y1 += c[1] * s; y2 += c[2] * s;
+        }
+        const float samplePeak = std::max(std::abs(x(delay)), std::abs(x(delay + 1)));
+        return std::max({ samplePeak, std::abs(y0), std::abs(y1), std::abs(y2) });
+    }
+
+private:
+    static_assert(oversampling == 4, "process() unrolls three phases");
+    std::array<std::array<float, oversampling - 1>, tapsPerPhase> coeffs{}; // [tap][phase]
+};
@@ -47,7 +47,8 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
     setSize(960, 800);
-    scopeData.resize(1024, 0.0f);
+    scopeFrames.resize(scopeLength);
+    streamBuffer.resize(MeterStream::fifoSize);
 
     auto& lf = getLookAndFeel();
     juce::Font jpFont = juce::Font("Meiryo UI", 16.0f, juce::Font::plain);
@@ -108,7 +109,7 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
     addAndMakeVisible(presetCombo);
     presetCombo.clear();
 
-    for (int i = 0; i < audioProcessor.presetList.size(); ++i) {
+    for (int i = 0; i < (int)audioProcessor.presetList.size(); ++i) {
         // インデックス番号を新しいプリセット数に合わせて修正
         if (i == 0)       presetCombo.addSectionHeading("--- MODERN KICKS ---");
         else if (i == 48) presetCombo.addSectionHeading("--- VINTAGE KICKS ---");
@@ -152,16 +153,16 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
         utf8("【パルス波】幅を調整可能な矩形波。細くすると鋭いクリックになります。"),
         utf8("【サイン波】倍音なし。特定の周波数（Freq）をピンポイントで補強します。")
     };
-    createCombo(atkWaveCombo, "atkWave", "Type", utf8("波形タイプ"), utf8("アタック成分の波形ソースを選択します。"), atkWaves, atkDescs);
+    createCombo(atkWaveCombo, pAtkWave, "Type", utf8("波形タイプ"), utf8("アタック成分の波形ソースを選択します。"), atkWaves, atkDescs);
 
-    createSlider(atkDecaySlider, "atkDecay", "Decay", utf8("減衰時間"), "s", utf8("クリック音の長さを調整します。短くすると鋭く、長くすると太くなります。"));
-    createSlider(atkCurveSlider, "atkCurve", "Curve", utf8("カーブ"), "", utf8("エンベロープの急峻さ。値を大きくするとアタックがより鋭角的になります。"));
-    createSlider(atkToneSlider, "atkTone", "Tone", utf8("トーン(LPF)"), "Hz", utf8("ローパスフィルタ。高域のザラつきを削り、耳障りな成分を抑えます。"), true);
-    createSlider(atkHPFSlider, "atkHPF", "Hi-Pass", utf8("ハイパス"), "Hz", utf8("ハイパスフィルタ。不要な低域をカットし、Bodyとの濁りを防ぎます。"), true);
-    createSlider(atkLevelSlider, "atkLevel", "Level", utf8("音量"), "x", utf8("アタックレイヤーのミックス音量です。"));
-    createSlider(atkPanSlider, "atkPan", "Pan", utf8("定位"), "LR", utf8("左右のバランスを調整します。"));
-    createSlider(atkPitchSlider, "atkPitch", "Freq", utf8("周波数"), "Hz", utf8("幾何学波形（Sine/Saw/Pulse）選択時の基本ピッチです。"), true);
-    createSlider(atkPWSlider, "atkPulseWidth", "Width", utf8("パルス幅"), "%", utf8("矩形波/パルス波の太さ。50%で完全な矩形波、小さくすると細くなります。"));
+    createSlider(atkDecaySlider, pAtkDecay, "Decay", utf8("減衰時間"), "s", utf8("クリック音の長さを調整します。短くすると鋭く、長くすると太くなります。"));
+    createSlider(atkCurveSlider, pAtkCurve, "Curve", utf8("カーブ"), "", utf8("エンベロープの急峻さ。値を大きくするとアタックがより鋭角的になります。"));
+    createSlider(atkToneSlider, pAtkTone, "Tone", utf8("トーン(LPF)"), "Hz", utf8("ローパスフィルタ。高域のザラつきを削り、耳障りな成分を抑えます。"), true);
+    createSlider(atkHPFSlider, pAtkHPF, "Hi-Pass", utf8("ハイパス"), "Hz", utf8("ハイパスフィルタ。不要な低域をカットし、Bodyとの濁りを防ぎます。"), true);
+    createSlider(atkLevelSlider, pAtkLevel, "Level", utf8("音量"), "x", utf8("アタックレイヤーのミックス音量です。"));
+    createSlider(atkPanSlider, pAtkPan, "Pan", utf8("定位"), "LR", utf8("左右のバランスを調整します。"));
+    createSlider(atkPitchSlider, pAtkPitch, "Freq", utf8("周波数"), "Hz", utf8("幾何学波形（Sine/Saw/Pulse）選択時の基本ピッチです。"), true);
+    createSlider(atkPWSlider, pAtkPulseWidth, "Width", utf8("パルス幅"), "%", utf8("矩形波/パルス波の太さ。50%で完全な矩形波、小さくすると細くなります。"));
 
     juce::StringArray bodyWaves{
         utf8("Ultra Sine (サイン波)"), utf8("Bessel (ベッセル/FM)"), utf8("Saw (ノコギリ波)"), utf8("Square (矩形波)"), utf8("Triangle (三角波)")
@@ -173,29 +174,29 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
         utf8("【矩形波】中域が空洞化した、独特のボックス感がある低音です。"),
         utf8("【三角波】サイン波に近いですが、わずかにエッジがあり存在感が出ます。")
     };
-    createCombo(bodyWaveCombo, "bodyWave", "Type", utf8("波形タイプ"), utf8("キックの核（ボディ）となる波形を選択します。"), bodyWaves, bodyDescs);
-
-    createSlider(pStartSlider, "pStart", "P.Start", utf8("ピッチ開始"), "Hz", utf8("スイープ開始周波数。高いほど「バチッ」というパンチ感が強まります。"), true);
-    createSlider(pEndSlider, "pEnd", "P.End", utf8("ピッチ終了"), "Hz", utf8("スイープ到達点。キックの基音（音程）となります。"), true);
-    createSlider(pDecaySlider, "pDecay", "P.Decay", utf8("ピッチ減衰"), "s", utf8("ピッチが下がりきるまでの時間。キックの「重さ」に関わります。"));
-    createSlider(pCurveSlider, "pCurve", "P.Curve", utf8("ピッチカーブ"), "", utf8("下降の形状。大きくすると初期のアタック感が強調されます。"));
-    createSlider(pGlideSlider, "pGlide", "Tension", utf8("張力"), "", utf8("膜の物理的な張力変化（Von Karman式）を再現し、独特の粘りを加えます。"));
-    createSlider(bDecaySlider, "bodyDecay", "A.Decay", utf8("音量減衰"), "s", utf8("ボディの鳴っている長さ（余韻）を調整します。"));
-    createSlider(bCurveSlider, "bodyCurve", "A.Curve", utf8("音量カーブ"), "", utf8("音量の減衰カーブ。大きくするとタイトに、小さくするとサステインが増します。"));
-    createSlider(bRatioSlider, "besselRatio", "FM Ratio", utf8("FM比"), "", utf8("Bessel波形選択時の倍音比率。値を上げると金属的な響きになります。"));
-    createSlider(bFilterSlider, "bodyFilter", "LPF", utf8("ローパス"), "Hz", utf8("ボディの高域を丸め、よりサブベースに近い質感にします。"), true);
-    createSlider(bLevelSlider, "bodyLevel", "Level", utf8("音量"), "x", utf8("ボディレイヤーのミックス音量です。"));
-    createSlider(bPanSlider, "bodyPan", "Pan", utf8("定位"), "LR", utf8("左右のバランスを調整します。"));
-
-    createSlider(subNoteSlider, "subNote", "Note", utf8("ノート"), "", utf8("KeyTrackオフ時の固定ピッチです。"), false, true);
-    createSlider(subFineSlider, "subFine", "Fine", utf8("微調整"), "Hz", utf8("周波数の微調整。Bodyとの位相干渉やうなり（Beat）を調整します。"));
-    createButton(subTrackButton, "subTrack", utf8("キー追従"), utf8("オンにすると入力MIDIノートの音程で鳴ります。ベースライン専用。Levelにマウスを合わせると音程を確認できます。"));
-    createSlider(subDecaySlider, "subDecay", "Decay", utf8("減衰時間"), "s", utf8("サブベースの長さ。Bodyより少し長くして余韻を作ると効果的です。"));
-    createSlider(subCurveSlider, "subCurve", "Curve", utf8("カーブ"), "", utf8("減衰カーブ。サブベースは急峻（>3.0）にしてタイトにするのが定石です。"));
-    createSlider(subLevelSlider, "subLevel", "Level", utf8("音量"), "x", utf8("サブレイヤーのミックス音量です。"), false, false, true);
-    createSlider(subPhaseSlider, "subPhase", "Phase", utf8("位相"), "deg", utf8("Bodyに対する位相ズレ。低域の打ち消し合いを防ぐために調整します。"));
-    createSlider(subAntiClickSlider, "subAntiClick", "Anti-Click", utf8("アンチクリック"), "ms", utf8("発音開始時の微小フェードイン。ゼロ交差ノイズを防ぎます。"));
-    createSlider(subPanSlider, "subPan", "Pan", utf8("定位"), "LR", utf8("左右のバランス。低域はセンター（0）が推奨されます。"));
+    createCombo(bodyWaveCombo, pBodyWave, "Type", utf8("波形タイプ"), utf8("キックの核（ボディ）となる波形を選択します。"), bodyWaves, bodyDescs);
+
+    createSlider(pStartSlider, pPStart, "P.Start", utf8("ピッチ開始"), "Hz", utf8("スイープ開始周波数。高いほど「バチッ」というパンチ感が強まります。"), true);
+    createSlider(pEndSlider, pPEnd, "P.End", utf8("ピッチ終了"), "Hz", utf8("スイープ到達点。キックの基音（音程）となります。"), true);
+    createSlider(pDecaySlider, pPDecay, "P.Decay", utf8("ピッチ減衰"), "s", utf8("ピッチが下がりきるまでの時間。キックの「重さ」に関わります。"));
+    createSlider(pCurveSlider, pPCurve, "P.Curve", utf8("ピッチカーブ"), "", utf8("下降の形状。大きくすると初期のアタック感が強調されます。"));
+    createSlider(pGlideSlider, pPGlide, "Tension", utf8("張力"), "", utf8("膜の物理的な張力変化（Von Karman式）を再現し、独特の粘りを加えます。"));
+    createSlider(bDecaySlider, pBodyDecay, "A.Decay", utf8("音量減衰"), "s", utf8("ボディの鳴っている長さ（余韻）を調整します。"));
+    createSlider(bCurveSlider, pBodyCurve, "A.Curve", utf8("音量カーブ"), "", utf8("音量の減衰カーブ。大きくするとタイトに、小さくするとサステインが増します。"));
+    createSlider(bRatioSlider, pBesselRatio, "FM Ratio", utf8("FM比"), "", utf8("Bessel波形選択時の倍音比率。値を上げると金属的な響きになります。"));
+    createSlider(bFilterSlider, pBodyFilter, "LPF", utf8("ローパス"), "Hz", utf8("ボディの高域を丸め、よりサブベースに近い質感にします。"), true);
+    createSlider(bLevelSlider, pBodyLevel, "Level", utf8("音量"), "x", utf8("ボディレイヤーのミックス音量です。"));
+    createSlider(bPanSlider, pBodyPan, "Pan", utf8("定位"), "LR", utf8("左右のバランスを調整します。"));
+
+    createSlider(subNoteSlider, pSubNote, "Note", utf8("ノート"), "", utf8("KeyTrackオフ時の固定ピッチです。"), false, true);
+    createSlider(subFineSlider, pSubFine, "Fine", utf8("微調整"), "Hz", utf8("周波数の微調整。Bodyとの位相干渉やうなり（Beat）を調整します。"));
+    createButton(subTrackButton, pSubTrack, "Key Track", utf8("キー追従"), utf8("オンにすると入力MIDIノートの音程で鳴ります。ベースライン専用。Levelにマウスを合わせると音程を確認できます。"));
+    createSlider(subDecaySlider, pSubDecay, "Decay", utf8("減衰時間"), "s", utf8("サブベースの長さ。Bodyより少し長くして余韻を作ると効果的です。"));
+    createSlider(subCurveSlider, pSubCurve, "Curve", utf8("カーブ"), "", utf8("減衰カーブ。サブベースは急峻（>3.0）にしてタイトにするのが定石です。"));
+    createSlider(subLevelSlider, pSubLevel, "Level", utf8("音量"), "x", utf8("サブレイヤーのミックス音量です。"), false, false, true);
+    createSlider(subPhaseSlider, pSubPhase, "Phase", utf8("位相"), "deg", utf8("Bodyに対する位相ズレ。低域の打ち消し合いを防ぐために調整します。"));
+    createSlider(subAntiClickSlider, pSubAntiClick, "Anti-Click", utf8("アンチクリック"), "ms", utf8("発音開始時の微小フェードイン。ゼロ交差ノイズを防ぎます。"));
+    createSlider(subPanSlider, pSubPan, "Pan", utf8("定位"), "LR", utf8("左右のバランス。低域はセンター（0）が推奨されます。"));
 
     juce::StringArray satTypes{
         utf8("Soft Tanh (ソフト/温かみ)"), utf8("Hard Clip (デジタル)"), utf8("Triode (真空管/三極管)"), utf8("Tape (テープ/粘り)"),
@@ -215,7 +216,7 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
         utf8("【Exciter】高域成分のみを歪ませて加算します。音の抜けときらびやかさを付加。"),
         utf8("【Cubic】3次多項式。原音のニュアンスを保ちつつ太くするクリーンな歪み。")
     };
-    createCombo(satTypeCombo, "satType", "Distort", utf8("歪みタイプ"), utf8("サチュレーションのアルゴリズムを選択します。"), satTypes, satDescs);
+    createCombo(satTypeCombo, pSatType, "Distort", utf8("歪みタイプ"), utf8("サチュレーションのアルゴリズムを選択します。"), satTypes, satDescs);
 
     juce::StringArray osTypes{ "Off", "2x (Standard)", "4x (High)", "8x (Ultra)" };
     juce::StringArray osDescs{
@@ -224,26 +225,56 @@ NextGenKickAudioProcessorEditor::NextGenKickAudioProcessorEditor(NextGenKickAudi
         utf8("【4x】高音質モード。激しい歪みを加える場合に適していますが、CPU負荷が増加します。"),
         utf8("【8x】最高品質。ほぼ完全にエイリアシングを除去しますが、非常に高いCPU負荷がかかります。")
     };
-    createCombo(osCombo, "osMode", "Quality", utf8("品質設定"), utf8("オーバーサンプリング倍率。高くすると高域の折り返しノイズが減り、よりクリアな歪みになります。"), osTypes, osDescs);
+    createCombo(osCombo, pOsMode, "Quality", utf8("品質設定"), utf8("オーバーサンプリング倍率。高くすると高域の折り返しノイズが減り、よりクリアな歪みになります。"), osTypes, osDescs);
+
+    juce::StringArray polyTypes{ "1 Voice", "2 Voices", "4 Voices", "8 Voices", "16 Voices" };
+    juce::StringArray polyDescs{
+        utf8("【1】モノフォニック。新しいノートで前の余韻をカットします（従来の動作）。"),
+        utf8("【2】直前のキックの余韻を1つだけ残します。"),
+        utf8("【4】速いロールでも余韻が重なります。"),
+        utf8("【8】異なるノートのキックをレイヤーする場合に。"),
+        utf8("【16】最大同時発音数。CPU負荷は発音中のボイス数に比例します。")
+    };
+    createCombo(polyCombo, pPolyphony, "Voices", utf8("同時発音数"), utf8("同時に鳴らせるキックの数。ロールやレイヤー時に余韻を重ねます。"), polyTypes, polyDescs);
+
+    juce::StringArray stealTypes{ "Oldest", "Quietest", "Same Note" };
+    juce::StringArray stealDescs{
+        utf8("【Oldest】発音数が上限に達したら、最も古いボイスを再利用します。"),
+        utf8("【Quietest】最も音量の小さいボイスを再利用します。余韻が目立ちにくい設定です。"),
+        utf8("【Same Note】同じノートが鳴っていればそのボイスを再トリガーします。それ以外はOldestと同じです。")
+    };
+    createCombo(stealCombo, pVoiceSteal, "Steal", utf8("ボイススチール"), utf8("発音数が上限に達した時に、どのボイスを再利用するかを選択します。"), stealTypes, stealDescs);
 
-    createSlider(mDriveSlider, "masterDrive", "Drive", utf8("ドライブ"), "x", utf8("歪みの深さ。音量は自動補正されるため、質感の調整に集中できます。"));
-    createSlider(mOutSlider, "masterOut", "Volume", utf8("出力音量"), "x", utf8("最終的な出力レベルです。"));
-    createSlider(mWidthSlider, "masterWidth", "Width", utf8("ステレオ幅"), "x", utf8("0で完全モノラル、1でステレオ。キックは少し狭めるのが定石です。"));
-    createSlider(limThreshSlider, "limThreshold", "Ceil", utf8("シーリング"), "dB", utf8("リミッターが作動する上限レベル。0dB推奨。"));
-    createSlider(limLookSlider, "limLookahead", "Lookahead", "ms", utf8("先読み"), utf8("リミッターの反応速度。アタックのトランジェントを保護します。"));
-    createSlider(mPhaseSlider, "masterPhase", "Phase", utf8("開始位相"), "deg", utf8("全レイヤー共通の波形開始位置。アタックの出音を安定させます。"));
-    createSlider(mReleaseSlider, "masterRelease", "Gate", utf8("ゲート"), "s", utf8("ノートオフ後の強制音止め時間（安全装置）。"));
+    createSlider(mDriveSlider, pMasterDrive, "Drive", utf8("ドライブ"), "x", utf8("歪みの深さ。音量は自動補正されるため、質感の調整に集中できます。"));
+    createSlider(mOutSlider, pMasterOut, "Volume", utf8("出力音量"), "x", utf8("最終的な出力レベルです。"));
+    createSlider(mWidthSlider, pMasterWidth, "Width", utf8("ステレオ幅"), "x", utf8("0で完全モノラル、1でステレオ。キックは少し狭めるのが定石です。"));
+    createSlider(limThreshSlider, pLimThreshold, "Ceil", utf8("シーリング"), "dB", utf8("リミッターが作動する上限レベル。0dB推奨。"));
+    createSlider(limLookSlider, pLimLookahead, "Lookahead", "ms", utf8("先読み"), utf8("リミッターの反応速度。アタックのトランジェントを保護します。"));
+    createSlider(mPhaseSlider, pMasterPhase, "Phase", utf8("開始位相"), "deg", utf8("全レイヤー共通の波形開始位置。アタックの出音を安定させます。"));
+    createSlider(mReleaseSlider, pMasterRelease, "Gate", utf8("ゲート"), "s", utf8("ノートオフ後の強制音止め時間（安全装置）。"));
 
     // Added Master LPF Slider
-    createSlider(masterLPFSlider, "masterLPF", "Hi-Cut", utf8("ハイカット"), "Hz", utf8("最終段のローパスフィルタ。クリックノイズや高域のザラつきを除去します。"), true);
+    createSlider(masterLPFSlider, pMasterLPF, "Hi-Cut", utf8("ハイカット"), "Hz", utf8("最終段のローパスフィルタ。クリックノイズや高域のザラつきを除去します。"), true);
+    createButton(truePeakButton, pLimTruePeak, "True Peak", utf8("トゥルーピーク"), utf8("リミッターがサンプル間のピーク（4倍オーバーサンプリングで検出）も抑えます。レイテンシーが5サンプル増えます。"));
+
+    juce::StringArray layerOutTypes{ "Pre Master", "Post Master" };
+    juce::StringArray layerOutDescs{
+        utf8("【Pre Master】各レイヤーのフィルター後・パン後の信号を、マスター処理を通さずに出力します。"),
+        utf8("【Post Master】ドライブのゲイン、音量、ハイカット、ステレオ幅、リミッターのゲインを反映して出力します（歪みはメイン出力のみ）。")
+    };
+    createCombo(layerOutCombo, pLayerOutMode, "Stems", utf8("レイヤー出力"), utf8("追加出力バス（Attack / Body / Sub）に送る信号。DAWでバスを有効にすると、メイン出力と同じタイミングで各レイヤーを個別に出力します。"), layerOutTypes, layerOutDescs);
 
     // CHANGED: Use logo_jpg
     logoImage = juce::ImageCache::getFromMemory(BinaryData::logo_jpg, BinaryData::logo_jpgSize);
 
-    startTimerHz(60);
+    audioProcessor.setStaticPreviewActive(true);
+    startTimerHz(frameRateHz);
 }
 
-NextGenKickAudioProcessorEditor::~NextGenKickAudioProcessorEditor() { stopTimer(); }
+NextGenKickAudioProcessorEditor::~NextGenKickAudioProcessorEditor() {
+    stopTimer();
+    audioProcessor.setStaticPreviewActive(false);
+}
 
 void NextGenKickAudioProcessorEditor::mouseUp(const juce::MouseEvent& e) {
     if (e.eventComponent == &infoBar) {
@@ -251,7 +282,7 @@ void NextGenKickAudioProcessorEditor::mouseUp(const juce::MouseEvent& e) {
     }
 }
 
-void NextGenKickAudioProcessorEditor::createSlider(InfoBarSlider& slider, const juce::String& paramID, const juce::String& nameEN, const juce::String& nameJP, const juce::String& unit, const juce::String& desc, bool isFreq, bool isNote, bool reqKeyTrack) {
+void NextGenKickAudioProcessorEditor::createSlider(InfoBarSlider& slider, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& unit, const juce::String& desc, bool isFreq, bool isNote, bool reqKeyTrack) {
     addAndMakeVisible(slider);
     slider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
     slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
@@ -263,10 +294,11 @@ void NextGenKickAudioProcessorEditor::createSlider(InfoBarSlider& slider, const
 
     slider.onInfoUpdate = [this](const juce::String& s, bool b) { updateInfoBar(s, b); };
     slider.onInfoClear = [this]() { clearInfoBar(); };
-    sliderAttachments.push_back(std::make_unique<SliderAtt>(audioProcessor.apvts, paramID, slider));
+    sliderAttachments.push_back(std::make_unique<SliderAtt>(audioProcessor.apvts, paramSpec(param).id, slider));
 }
 
-void NextGenKickAudioProcessorEditor::createCombo(InfoBarCombo& combo, const juce::String& paramID, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc, const juce::StringArray& items, const juce::StringArray& itemDescs) {
+void NextGenKickAudioProcessorEditor::createCombo(InfoBarCombo& combo, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc, const juce::StringArray& items, const juce::StringArray& itemDescs) {
+    jassert(paramSpec(param).type == ParamType::Choice && items.size() == paramSpec(param).numChoices);
     addAndMakeVisible(combo);
     combo.addItemList(items, 1);
     combo.nameEN = nameEN; combo.nameJP = nameJP; combo.description = desc; combo.itemDescriptions = itemDescs;
@@ -276,25 +308,23 @@ void NextGenKickAudioProcessorEditor::createCombo(InfoBarCombo& combo, const juc
     combo.getRootMenu()->setLookAndFeel(&getLookAndFeel());
     combo.onChange = [&combo] { if (combo.isMouseOver()) combo.updateInfo(); };
 
-    if (paramID == "atkWave") atkWaveAtt = std::make_unique<ComboAtt>(audioProcessor.apvts, paramID, combo);
-    else if (paramID == "bodyWave") bodyWaveAtt = std::make_unique<ComboAtt>(audioProcessor.apvts, paramID, combo);
-    else if (paramID == "satType") satTypeAtt = std::make_unique<ComboAtt>(audioProcessor.apvts, paramID, combo);
-    else if (paramID == "osMode") osAtt = std::make_unique<ComboAtt>(audioProcessor.apvts, paramID, combo);
+    comboAttachments.push_back(std::make_unique<ComboAtt>(audioProcessor.apvts, paramSpec(param).id, combo));
 }
 
-void NextGenKickAudioProcessorEditor::createButton(InfoBarButton& button, const juce::String& paramID, const juce::String& nameJP, const juce::String& desc) {
+void NextGenKickAudioProcessorEditor::createButton(InfoBarButton& button, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc) {
+    jassert(paramSpec(param).type == ParamType::Bool);
     addAndMakeVisible(button);
-    button.setButtonText(paramID == "subTrack" ? "Key Track" : "HQ Mode");
+    button.setButtonText(nameEN);
     button.nameJP = nameJP; button.description = desc;
     button.onInfoUpdate = [this](const juce::String& s) { updateInfoBar(s); };
     button.onInfoClear = [this]() { clearInfoBar(); };
-    if (paramID == "subTrack") subTrackAtt = std::make_unique<ButtonAtt>(audioProcessor.apvts, paramID, button);
+    buttonAttachments.push_back(std::make_unique<ButtonAtt>(audioProcessor.apvts, paramSpec(param).id, button));
 }
 
 void NextGenKickAudioProcessorEditor::updateInfoBar(const juce::String& text, bool addKeyTrackInfo) {
     juce::String finalText = text;
 
-    if (addKeyTrackInfo && audioProcessor.apvts.getRawParameterValue("subTrack")->load() > 0.5f) {
+    if (addKeyTrackInfo && audioProcessor.parameterValue(pSubTrack) > 0.5f) {
         int note = audioProcessor.lastMidiNote;
         double freq = 440.0 * std::pow(2.0, (note - 69.0) / 12.0);
 
@@ -312,42 +342,173 @@ void NextGenKickAudioProcessorEditor::updateInfoBar(const juce::String& text, bo
 void NextGenKickAudioProcessorEditor::clearInfoBar() { infoBar.setText(defaultInfoText, juce::dontSendNotification); }
 
 void NextGenKickAudioProcessorEditor::timerCallback() {
-    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
-    audioProcessor.visualFifo.prepareToRead(1024, start1, size1, start2, size2);
-
-    if (size1 + size2 > 0) {
-        float maxVal = 0.0f;
-
-        if (size1 > 0) {
-            for (int i = 0; i < size1; ++i) {
-                float v = audioProcessor.visualBuffer[start1 + i];
-                scopeData[scopeWriteIndex] = v;
-                scopeWriteIndex = (scopeWriteIndex + 1) % 1024;
-                maxVal = std::max(maxVal, std::abs(v));
-            }
+    updateFrame();
+
+    if (hoveringSlider && hoveringSlider->requiresKeyTrackInfo) {
+        hoveringSlider->updateInfo();
+    }
+}
+
+juce::RectangleList<int> NextGenKickAudioProcessorEditor::updateFrame() {
+    juce::RectangleList<int> dirty;
+
+    auto& stream = audioProcessor.meterStream;
+
+    // Scope frames: drained while idle too, so the scope never shows stale audio on wake-up
+    const int numScope = stream.read(MeterStream::scopeLevel, streamBuffer.data(), (int)streamBuffer.size());
+    for (int i = std::max(0, numScope - scopeLength); i < numScope; ++i) {
+        scopeFrames[(size_t)scopeWriteIndex] = streamBuffer[(size_t)i];
+        scopeWriteIndex = (scopeWriteIndex + 1) % scopeLength;
+    }
+    if (numScope > 0) {
+        // A flat line stays put: repaint the scope while it shows signal and once more after
+        const bool wasFlat = scopeFlat;
+        updateScopeColumns();
+        if (!(scopeFlat && wasFlat)) dirty.add(areaRealtimeScope);
+    }
+
+    // Meter: peak falling at meterFallDbPerSecond, RMS averaged over meterRmsSeconds
+    const int numMeter = stream.read(MeterStream::meterLevel, streamBuffer.data(), (int)streamBuffer.size());
+    if (numMeter > 0) {
+        const double frameSeconds = stream.getFrameSeconds(MeterStream::meterLevel);
+        const float fall = (float)std::pow(10.0, -meterFallDbPerSecond * frameSeconds / 20.0);
+        const float rmsCoeff = (float)(1.0 - std::exp(-frameSeconds / meterRmsSeconds));
+        for (int i = 0; i < numMeter; ++i) {
+            const auto& f = streamBuffer[(size_t)i];
+            meterPeak = std::max(f.peak(), meterPeak * fall);
+            meterMeanSquare += (f.meanSquare() - meterMeanSquare) * rmsCoeff;
         }
-        if (size2 > 0) {
-            for (int i = 0; i < size2; ++i) {
-                float v = audioProcessor.visualBuffer[start2 + i];
-                scopeData[scopeWriteIndex] = v;
-                scopeWriteIndex = (scopeWriteIndex + 1) % 1024;
-                maxVal = std::max(maxVal, std::abs(v));
-            }
+
+        auto barWidth = [this](float level) { return (int)(std::min(1.0f, level) * (float)areaOutputMeter.getWidth()); };
+        const int peakWidth = barWidth(meterPeak), rmsWidth = barWidth(std::sqrt(meterMeanSquare));
+        if (peakWidth != meterPeakWidth || rmsWidth != meterRmsWidth) {
+            meterPeakWidth = peakWidth; meterRmsWidth = rmsWidth;
+            dirty.add(areaOutputMeter);
         }
-        audioProcessor.visualFifo.finishedRead(size1 + size2);
+    }
 
-        currentOutputLevel *= 0.9f;
-        if (maxVal > currentOutputLevel) currentOutputLevel = maxVal;
+    if (audioProcessor.pullStaticPreview()) {
+        updatePreviewPaths();
+        dirty.add(areaStaticScope);
+    }
+
+    const juce::uint32 noteOns = audioProcessor.noteOnCount.load(std::memory_order_relaxed);
+    const bool newNote = noteOns != lastNoteOnCount;
+    lastNoteOnCount = noteOns;
 
-        repaint();
+    if (!dirty.isEmpty() || newNote) {
+        quietFrames = 0;
+        if (idle) { idle = false; startTimerHz(frameRateHz); }
+    }
+    else if (!idle && ++quietFrames >= quietFramesBeforeIdle) {
+        idle = true;
+        startTimerHz(idleRateHz);
     }
 
-    if (hoveringSlider && hoveringSlider->requiresKeyTrackInfo) {
-        hoveringSlider->updateInfo();
+    for (const auto& area : dirty) repaint(area);
+    return dirty;
+}
+
+// Min/max of the scope frames per pixel column, oldest frame on the left
+void NextGenKickAudioProcessorEditor::updateScopeColumns() {
+    const int n = scopeLength;
+    const int width = (int)scopeColumns.size();
+    scopeFlat = true;
+
+    for (int px = 0; px < width; ++px) {
+        const int begin = px * n / width;
+        const int end = std::max(begin + 1, (px + 1) * n / width);
+        const auto& first = scopeFrames[(size_t)((scopeWriteIndex + begin) % n)];
+        float lo = first.min, hi = first.max;
+        for (int i = begin + 1; i < end; ++i) {
+            const auto& f = scopeFrames[(size_t)((scopeWriteIndex + i) % n)];
+            lo = std::min(lo, f.min); hi = std::max(hi, f.max);
+        }
+        scopeColumns[(size_t)px] = { lo, hi };
+        if (hi > silenceLevel || lo < -silenceLevel) scopeFlat = false;
     }
 }
 
+// Outlines each layer's min/max band, one column per pixel. Runs when a new preview arrives or the
+// scope moves, so paint only fills the cached paths.
+void NextGenKickAudioProcessorEditor::updatePreviewPaths() {
+    pathAtk.clear(); pathBody.clear(); pathSub.clear();
+    const auto& frame = audioProcessor.getStaticPreview();
+    if (!frame.valid || areaStaticScope.isEmpty()) return;
+
+    float fullH = (float)areaStaticScope.getHeight(); float fullY = (float)areaStaticScope.getCentreY();
+    float fullX = (float)areaStaticScope.getX(); int width = areaStaticScope.getWidth();
+
+    auto outline = [&](const MinMaxPyramid& pyramid, juce::Path& path) {
+        const int n = pyramid.getLength();
+        auto column = [&](int px) { return pyramid.getRange((int)((juce::int64)px * n / width), (int)((juce::int64)(px + 1) * n / width)); };
+
+        path.startNewSubPath(fullX, fullY - column(0).getEnd() * fullH * 0.45f);
+        for (int px = 1; px < width; ++px) path.lineTo(fullX + (float)px, fullY - column(px).getEnd() * fullH * 0.45f);
+        for (int px = width - 1; px >= 0; --px) path.lineTo(fullX + (float)px, fullY - column(px).getStart() * fullH * 0.45f);
+        path.closeSubPath();
+    };
+
+    outline(frame.layers[layerAtk], pathAtk);
+    outline(frame.layers[layerBody], pathBody);
+    outline(frame.layers[layerSub], pathSub);
+}
+
 void NextGenKickAudioProcessorEditor::paint(juce::Graphics& g) {
+    // The static parts come from the cache; a frame usually only repaints the scopes and the meter
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!backgroundCache.isValid() || scale != backgroundScale) renderBackground(scale);
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+
+    // Meter
+    if (g.clipRegionIntersects(areaOutputMeter)) {
+        float level = std::min(1.0f, meterPeak);
+        juce::Colour col = level > 0.9f ? juce::Colours::red : (level > 0.7f ? juce::Colours::yellow : juce::Colours::green);
+        g.setColour(col.withAlpha(0.8f));
+        g.fillRect((float)areaOutputMeter.getX(), (float)areaOutputMeter.getY(), (float)meterPeakWidth, (float)areaOutputMeter.getHeight());
+        g.setColour(juce::Colours::white.withAlpha(0.25f)); // RMS inside the peak bar
+        g.fillRect((float)areaOutputMeter.getX(), (float)areaOutputMeter.getY(), (float)meterRmsWidth, (float)areaOutputMeter.getHeight());
+
+        g.setColour(juce::Colours::white); g.setFont(12.0f);
+        g.drawText("OUTPUT LEVEL", areaOutputMeter, juce::Justification::centred);
+    }
+
+    // Static preview: min/max bands built in updatePreviewPaths()
+    if (g.clipRegionIntersects(areaStaticScope)) {
+        g.setColour(juce::Colours::orange.withAlpha(0.6f)); g.fillPath(pathSub); g.strokePath(pathSub, juce::PathStrokeType(1.0f));
+        g.setColour(juce::Colours::green.withAlpha(0.7f)); g.fillPath(pathBody); g.strokePath(pathBody, juce::PathStrokeType(1.0f));
+        g.setColour(juce::Colours::red.withAlpha(0.9f)); g.fillPath(pathAtk); g.strokePath(pathAtk, juce::PathStrokeType(1.0f));
+
+        g.setColour(juce::Colours::white); g.setFont(12.0f);
+        g.drawText("STATIC PREVIEW", areaStaticScope.getX() + 5, areaStaticScope.getY() + 5, 100, 20, juce::Justification::left);
+    }
+
+    // Realtime scope: one vertical line per pixel column, min to max (updateScopeColumns())
+    if (g.clipRegionIntersects(areaRealtimeScope)) {
+        float oscH = (float)areaRealtimeScope.getHeight(); float oscY = (float)areaRealtimeScope.getCentreY();
+        int oscX = areaRealtimeScope.getX();
+        g.setColour(juce::Colours::cyan);
+        for (size_t px = 0; px < scopeColumns.size(); ++px) {
+            float top = oscY - scopeColumns[px].getEnd() * oscH * 0.45f;
+            float bottom = oscY - scopeColumns[px].getStart() * oscH * 0.45f;
+            g.drawVerticalLine(oscX + (int)px, top - 0.75f, bottom + 0.75f);
+        }
+
+        g.setColour(juce::Colours::white); g.setFont(12.0f);
+        g.drawText("REALTIME OUT", areaRealtimeScope.getX() + 5, areaRealtimeScope.getY() + 5, 100, 20, juce::Justification::left);
+    }
+}
+
+void NextGenKickAudioProcessorEditor::renderBackground(float scale) {
+    backgroundScale = scale;
+    backgroundCache = juce::Image(juce::Image::RGB, std::max(1, juce::roundToInt((float)getWidth() * scale)),
+                                  std::max(1, juce::roundToInt((float)getHeight() * scale)), false);
+    juce::Graphics g(backgroundCache);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    paintStaticParts(g);
+}
+
+void NextGenKickAudioProcessorEditor::paintStaticParts(juce::Graphics& g) {
     g.fillAll(juce::Colour(0xFF121212));
 
     // Meter
@@ -356,15 +517,6 @@ void NextGenKickAudioProcessorEditor::paint(juce::Graphics& g) {
     g.setColour(juce::Colours::darkgrey);
     g.drawRect((float)areaOutputMeter.getX(), (float)areaOutputMeter.getY(), (float)areaOutputMeter.getWidth(), (float)areaOutputMeter.getHeight());
 
-    float level = std::min(1.0f, currentOutputLevel);
-    float barW = level * (float)areaOutputMeter.getWidth();
-    juce::Colour col = level > 0.9f ? juce::Colours::red : (level > 0.7f ? juce::Colours::yellow : juce::Colours::green);
-    g.setColour(col.withAlpha(0.8f));
-    g.fillRect((float)areaOutputMeter.getX(), (float)areaOutputMeter.getY(), barW, (float)areaOutputMeter.getHeight());
-
-    g.setColour(juce::Colours::white); g.setFont(12.0f);
-    g.drawText("OUTPUT LEVEL", areaOutputMeter, juce::Justification::centred);
-
     // Headers
     auto drawHeader = [&](juce::Rectangle<int> area, juce::Colour bgCol, juce::Colour txtCol, juce::String text) {
         g.setColour(bgCol); g.fillRect(area);
@@ -391,39 +543,6 @@ void NextGenKickAudioProcessorEditor::paint(juce::Graphics& g) {
     g.setColour(juce::Colours::black); g.fillRect(areaStaticScope); g.fillRect(areaRealtimeScope);
     g.setColour(juce::Colours::grey); g.drawRect(areaStaticScope, 1.0f); g.drawRect(areaRealtimeScope, 1.0f);
 
-    pathAtk.clear(); pathBody.clear(); pathSub.clear();
-    float fullH = (float)areaStaticScope.getHeight(); float fullY = (float)areaStaticScope.getCentreY();
-    float fullW = (float)areaStaticScope.getWidth(); float fullX = (float)areaStaticScope.getX();
-    pathAtk.startNewSubPath(fullX, fullY); pathBody.startNewSubPath(fullX, fullY); pathSub.startNewSubPath(fullX, fullY);
-    if (!audioProcessor.isRecordingFullWave) {
-        for (int i = 0; i < audioProcessor.fullWaveSize; i += 40) {
-            float x = juce::jmap((float)i, 0.0f, (float)audioProcessor.fullWaveSize, fullX, fullX + fullW);
-            pathAtk.lineTo(x, fullY - (audioProcessor.fullWaveAtk[i] * fullH * 0.45f));
-            pathBody.lineTo(x, fullY - (audioProcessor.fullWaveBody[i] * fullH * 0.45f));
-            pathSub.lineTo(x, fullY - (audioProcessor.fullWaveSub[i] * fullH * 0.45f));
-        }
-    }
-    g.setColour(juce::Colours::orange.withAlpha(0.6f)); g.strokePath(pathSub, juce::PathStrokeType(1.5f));
-    g.setColour(juce::Colours::green.withAlpha(0.7f)); g.strokePath(pathBody, juce::PathStrokeType(1.2f));
-    g.setColour(juce::Colours::red.withAlpha(0.9f)); g.strokePath(pathAtk, juce::PathStrokeType(1.2f));
-
-    oscPath.clear();
-    float oscH = (float)areaRealtimeScope.getHeight(); float oscY = (float)areaRealtimeScope.getCentreY();
-    float oscW = (float)areaRealtimeScope.getWidth(); float oscX = (float)areaRealtimeScope.getX();
-    oscPath.startNewSubPath(oscX, oscY);
-    int readIdx = scopeWriteIndex;
-    for (int i = 0; i < 1024; i += 4) {
-        float val = scopeData[(readIdx + i) % 1024];
-        float x = juce::jmap((float)i, 0.0f, 1024.0f, oscX, oscX + oscW);
-        float y = oscY - (val * oscH * 0.45f);
-        oscPath.lineTo(x, y);
-    }
-    g.setColour(juce::Colours::cyan); g.strokePath(oscPath, juce::PathStrokeType(1.5f));
-
-    g.setColour(juce::Colours::white); g.setFont(12.0f);
-    g.drawText("STATIC PREVIEW", areaStaticScope.getX() + 5, areaStaticScope.getY() + 5, 100, 20, juce::Justification::left);
-    g.drawText("REALTIME OUT", areaRealtimeScope.getX() + 5, areaRealtimeScope.getY() + 5, 100, 20, juce::Justification::left);
-
     // --- Draw Logo (Image) ---
     // CHANGED: Maximize logo in remaining space
     g.setColour(juce::Colours::black);
@@ -463,6 +582,9 @@ void NextGenKickAudioProcessorEditor::resized() {
     auto scopeArea = bounds.removeFromTop(200);
     areaStaticScope = scopeArea.removeFromLeft(getWidth() / 2).reduced(5);
     areaRealtimeScope = scopeArea.reduced(5);
+    updatePreviewPaths();
+    scopeColumns.assign((size_t)std::max(0, areaRealtimeScope.getWidth()), {});
+    updateScopeColumns();
 
     auto controlsArea = bounds.reduced(5);
     int colWidth = controlsArea.getWidth() / 4;
@@ -506,14 +628,23 @@ void NextGenKickAudioProcessorEditor::resized() {
     layoutKnob(subAntiClickSlider, subPlace, 0, 2); layoutKnob(subPanSlider, subPlace, 1, 2);
 
     satTypeCombo.setBounds(masterPlace.removeFromTop(25).reduced(2));
-    osCombo.setBounds(masterPlace.removeFromTop(25).reduced(2));
+    auto osRow = masterPlace.removeFromTop(25);
+    osCombo.setBounds(osRow.removeFromLeft(osRow.getWidth() / 2).reduced(2));
+    polyCombo.setBounds(osRow.removeFromLeft(osRow.getWidth() / 2).reduced(2));
+    stealCombo.setBounds(osRow.reduced(2));
     layoutKnob(mDriveSlider, masterPlace, 0, 0); layoutKnob(mOutSlider, masterPlace, 1, 0); layoutKnob(mWidthSlider, masterPlace, 2, 0);
     layoutKnob(limThreshSlider, masterPlace, 0, 1); layoutKnob(limLookSlider, masterPlace, 1, 1); layoutKnob(mPhaseSlider, masterPlace, 2, 1);
     layoutKnob(mReleaseSlider, masterPlace, 0, 2); layoutKnob(masterLPFSlider, masterPlace, 1, 2);
+    // Free slot next to Hi-Cut: True Peak above the layer output mode
+    const int freeSlotY = masterPlace.getY() + 2 * knobH + 5 + (knobH - 55) / 2;
+    truePeakButton.setBounds(masterPlace.getX() + 2 * knobW + 5, freeSlotY, knobW, 25);
+    layerOutCombo.setBounds(masterPlace.getX() + 2 * knobW + 5, freeSlotY + 30, knobW, 25);
 
     // CHANGED: Maximize Logo Area (Fill remaining space below knobs)
     int knobsHeight = 3 * 95;
     auto logoSpace = masterPlace;
     logoSpace.removeFromTop(knobsHeight + 10); // Skip knobs + padding
     areaLogo = logoSpace.reduced(5); // Use all remaining space
+
+    backgroundCache = {}; // redrawn at the new layout by the next paint
 }
\ No newline at end of file
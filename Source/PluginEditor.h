@@ -69,15 +69,24 @@ public:
 
     void mouseUp(const juce::MouseEvent& e) override;
 
+    // One display frame: takes new scope, meter and preview data and repaints only the areas that
+    // changed. Returns those areas (empty while idle); the timer calls it, and so does the
+    // renderer's --bench-editor, which has no message loop.
+    juce::RectangleList<int> updateFrame();
+
 private:
     void timerCallback() override;
+    void updatePreviewPaths();
+    void updateScopeColumns();
+    void renderBackground(float scale);
+    void paintStaticParts(juce::Graphics& g);
 
     void updateInfoBar(const juce::String& text, bool addKeyTrackInfo = false);
     void clearInfoBar();
 
-    void createSlider(InfoBarSlider& slider, const juce::String& paramID, const juce::String& nameEN, const juce::String& nameJP, const juce::String& unit, const juce::String& desc, bool isFreq = false, bool isNote = false, bool reqKeyTrack = false);
-    void createCombo(InfoBarCombo& combo, const juce::String& paramID, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc, const juce::StringArray& items, const juce::StringArray& itemDescs);
-    void createButton(InfoBarButton& button, const juce::String& paramID, const juce::String& nameJP, const juce::String& desc);
+    void createSlider(InfoBarSlider& slider, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& unit, const juce::String& desc, bool isFreq = false, bool isNote = false, bool reqKeyTrack = false);
+    void createCombo(InfoBarCombo& combo, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc, const juce::StringArray& items, const juce::StringArray& itemDescs);
+    void createButton(InfoBarButton& button, ParamId param, const juce::String& nameEN, const juce::String& nameJP, const juce::String& desc);
 
     NextGenKickAudioProcessor& audioProcessor;
 
@@ -115,22 +124,26 @@ private:
     // Master
     InfoBarCombo satTypeCombo;
     InfoBarCombo osCombo;
+    InfoBarCombo polyCombo, stealCombo;
     InfoBarSlider mDriveSlider, mOutSlider, mWidthSlider;
     InfoBarSlider mReleaseSlider, mPhaseSlider, limThreshSlider, limLookSlider;
     InfoBarSlider masterLPFSlider;
+    InfoBarButton truePeakButton;
+    InfoBarCombo layerOutCombo;
 
-    // Attachments
+    // Attachments, one per control, bound through paramTable IDs
     using SliderAtt = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ComboAtt = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
     using ButtonAtt = juce::AudioProcessorValueTreeState::ButtonAttachment;
 
     std::vector<std::unique_ptr<SliderAtt>> sliderAttachments;
-    std::unique_ptr<ComboAtt> atkWaveAtt, bodyWaveAtt, satTypeAtt, osAtt;
-    std::unique_ptr<ButtonAtt> subTrackAtt;
+    std::vector<std::unique_ptr<ComboAtt>> comboAttachments;
+    std::vector<std::unique_ptr<ButtonAtt>> buttonAttachments;
 
     // Visualization
-    juce::Path oscPath;
-    juce::Path pathAtk, pathBody, pathSub;
+    juce::Path pathAtk, pathBody, pathSub; // static preview bands, rebuilt by updatePreviewPaths()
+    std::vector<juce::Range<float>> scopeColumns; // realtime scope min/max per pixel column
+    bool scopeFlat = true;                        // every column below silenceLevel
     juce::Rectangle<int> areaStaticScope, areaRealtimeScope, areaMeter;
 
     // Layout Areas
@@ -138,9 +151,27 @@ private:
     juce::Rectangle<int> areaOutputMeter;
     juce::Rectangle<int> areaLogo;
 
-    float currentOutputLevel = 0.0f;
-    std::vector<float> scopeData;
+    // Realtime scope and meter, fed from the processor's MeterStream
+    static constexpr int scopeLength = 256;          // scope frames on screen, ~21 ms
+    static constexpr double meterFallDbPerSecond = 55.0, meterRmsSeconds = 0.3;
+    std::vector<MeterFrame> scopeFrames;             // ring, oldest at scopeWriteIndex
     int scopeWriteIndex = 0;
+    std::vector<MeterFrame> streamBuffer;            // one read of the stream
+    float meterPeak = 0.0f, meterMeanSquare = 0.0f;
+    int meterPeakWidth = 0, meterRmsWidth = 0;       // bar widths in pixels, as last painted
+
+    // Everything that does not move (panels, labels, frames, logo), drawn once per size and scale
+    juce::Image backgroundCache;
+    float backgroundScale = 0.0f;
+
+    // Frame scheduling: after quietFramesBeforeIdle frames without anything to repaint the timer
+    // drops to idleRateHz, just fast enough to notice new audio or a new preview
+    static constexpr int frameRateHz = 60, idleRateHz = 10;
+    static constexpr int quietFramesBeforeIdle = 30;
+    static constexpr float silenceLevel = 1.0e-4f;
+    int quietFrames = 0;
+    bool idle = false;
+    juce::uint32 lastNoteOnCount = 0;
 
     InfoBarSlider* hoveringSlider = nullptr;
     juce::String defaultInfoText;
@@ -1,81 +1,83 @@
 #include "PluginProcessor.h"
+#if ! NGK_HEADLESS
 #include "PluginEditor.h"
+#endif
 #include <algorithm>
 #include <cmath>
 
+// Parameters behind NextGenKickAudioProcessor::VoiceParam, in enum order
+static constexpr ParamId voiceParamSources[] = {
+    pAtkDecay, pAtkCurve, pAtkTone, pAtkLevel, pAtkPan, pAtkPitch, pAtkHPF, pAtkPulseWidth,
+    pPStart, pPEnd, pPDecay, pPGlide, pPCurve, pBodyDecay, pBodyCurve, pBodyLevel, pBodyPan, pBesselRatio, pBodyFilter,
+    pSubNote, pSubFine, pSubDecay, pSubCurve, pSubLevel, pSubAntiClick, pSubPan,
+    pMasterDrive, pMasterOut, pMasterRelease, pLimThreshold, pMasterLPF
+};
+
+// Parameters behind NextGenKickAudioProcessor::BlockParam, in enum order
+static constexpr ParamId blockParamSources[] = {
+    pSatType, pAtkWave, pBodyWave, pSubTrack, pPolyphony, pVoiceSteal, pOsMode, pLimLookahead, pLimTruePeak, pLayerOutMode
+};
+
+// Each list holds exactly the table's parameters of its smoothing kind
+template <size_t N>
+static constexpr bool allSmoothedAs(const ParamId (&list)[N], ParamSmoothing smoothing) {
+    for (auto p : list)
+        if (paramSpec(p).smoothing != smoothing) return false;
+    return (int)N == countParams(smoothing);
+}
+
 NextGenKickAudioProcessor::NextGenKickAudioProcessor()
-    : AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+    : AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true)
+                                      .withOutput("Attack", juce::AudioChannelSet::stereo(), false)
+                                      .withOutput("Body", juce::AudioChannelSet::stereo(), false)
+                                      .withOutput("Sub", juce::AudioChannelSet::stereo(), false)),
     apvts(*this, &undoManager, "Parameters", createParameterLayout())
 {
     limBufferL.resize(limBufferSize, 0.0f);
     limBufferR.resize(limBufferSize, 0.0f);
+    limPeakWindow.prepare(limBufferSize);
+    for (auto& ring : layerRing) ring.resize(limBufferSize, 0.0f);
+
+    for (int p = 0; p < numParams; ++p) {
+        paramRaw[(size_t)p] = apvts.getRawParameterValue(paramTable[(size_t)p].id);
+        paramObjects[(size_t)p] = apvts.getParameter(paramTable[(size_t)p].id);
+        jassert(paramRaw[(size_t)p] != nullptr && paramObjects[(size_t)p] != nullptr);
+    }
 
-    visualBuffer.resize(visualBufferSize, 0.0f);
-    fullWaveAtk.resize(fullWaveSize, 0.0f);
-    fullWaveBody.resize(fullWaveSize, 0.0f);
-    fullWaveSub.resize(fullWaveSize, 0.0f);
+    static_assert(sizeof(voiceParamSources) / sizeof(voiceParamSources[0]) == numVoiceParams, "voiceParamSources out of sync");
+    static_assert(allSmoothedAs(voiceParamSources, ParamSmoothing::Span), "voice parameters must be the table's Span ones");
+    for (int p = 0; p < numVoiceParams; ++p) voiceParamRaw[(size_t)p] = paramRaw[(size_t)voiceParamSources[p]];
 
-    satStates.resize(2);
+    static_assert(sizeof(blockParamSources) / sizeof(blockParamSources[0]) == numBlockParams, "blockParamSources out of sync");
+    static_assert(allSmoothedAs(blockParamSources, ParamSmoothing::Block), "block parameters must be the table's Block ones");
+    for (int p = 0; p < numBlockParams; ++p) blockParamRaw[(size_t)p] = paramRaw[(size_t)blockParamSources[p]];
+
+    static_assert(countParams(ParamSmoothing::Sample) == 3, "per-sample parameters: subPhase, masterWidth, masterPhase");
 
     initPresets();
+
+    // Picks up latency changes published by the audio thread
+    startTimerHz(20);
 }
 
-NextGenKickAudioProcessor::~NextGenKickAudioProcessor() {}
+NextGenKickAudioProcessor::~NextGenKickAudioProcessor() { stopTimer(); }
 
 juce::AudioProcessorValueTreeState::ParameterLayout NextGenKickAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-    auto createFloat = [&](juce::String id, juce::String name, float min, float max, float def) {
-        params.push_back(std::make_unique<juce::AudioParameterFloat>(id, name, min, max, def));
-        };
-
-    juce::StringArray atkWaves{ "White", "Pink", "Brown", "Square", "Saw", "Triangle", "Pulse", "Ultra Sine" };
-    params.push_back(std::make_unique<juce::AudioParameterChoice>("atkWave", "Atk Waveform", atkWaves, 0));
-    createFloat("atkDecay", "Atk Decay", 0.001f, 0.2f, 0.01f);
-    createFloat("atkCurve", "Atk Decay Curve", 0.1f, 10.0f, 2.0f);
-    createFloat("atkTone", "Atk Tone (Hi-Cut)", 100.0f, 20000.0f, 20000.0f);
-    createFloat("atkLevel", "Atk Level", 0.0f, 1.0f, 0.4f);
-    createFloat("atkPan", "Atk Panning", -1.0f, 1.0f, 0.0f);
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("atkPitch", "Atk Click Freq", juce::NormalisableRange<float>(100.0f, 15000.0f, 1.0f, 0.25f), 3000.0f));
-    createFloat("atkHPF", "Atk HighPass", 20.0f, 2000.0f, 200.0f);
-    createFloat("atkPulseWidth", "Atk Pulse Width", 0.01f, 0.99f, 0.5f);
-
-    params.push_back(std::make_unique<juce::AudioParameterChoice>("bodyWave", "Body Waveform", juce::StringArray{ "Ultra Sine", "Bessel", "Saw", "Square", "Triangle" }, 0));
-    createFloat("pStart", "Body Pitch Start", 100.0f, 2000.0f, 350.0f);
-    createFloat("pEnd", "Body Pitch End", 20.0f, 150.0f, 43.6f);
-    createFloat("pDecay", "Body Pitch Decay", 0.01f, 0.5f, 0.07f);
-    createFloat("pGlide", "Von Karman Tension", 0.0f, 5.0f, 0.8f);
-    createFloat("pCurve", "Body Pitch Curve", 0.1f, 5.0f, 1.0f);
-    createFloat("bodyDecay", "Body Amp Decay", 0.05f, 1.5f, 0.35f);
-    createFloat("bodyCurve", "Body Amp Curve", 0.1f, 5.0f, 1.0f);
-    createFloat("bodyLevel", "Body Level", 0.0f, 1.0f, 0.75f);
-    createFloat("bodyPan", "Body Panning", -1.0f, 1.0f, 0.0f);
-    createFloat("besselRatio", "Bessel Ratio", 1.0f, 3.0f, 1.593f);
-    createFloat("bodyFilter", "Body LowPass", 100.0f, 12000.0f, 5000.0f);
-
-    createFloat("subNote", "Sub Note (MIDI)", 24.0f, 48.0f, 29.0f);
-    createFloat("subFine", "Sub Fine Tune (Hz)", -10.0f, 10.0f, 0.0f);
-    params.push_back(std::make_unique<juce::AudioParameterBool>("subTrack", "Key Tracking", false));
-    createFloat("subDecay", "Sub Amp Decay", 0.10f, 5.0f, 0.25f);
-    createFloat("subCurve", "Sub Decay Curve", 3.0f, 10.0f, 4.0f);
-    createFloat("subLevel", "Sub Level", 0.0f, 1.0f, 0.65f);
-    createFloat("subPhase", "Sub Phase Offset", 0.0f, 360.0f, 0.0f);
-    createFloat("subAntiClick", "Sub Anti-Click (ms)", 0.10f, 50.0f, 5.0f);
-    createFloat("subPan", "Sub Panning", -1.0f, 1.0f, 0.0f);
-
-    createFloat("masterDrive", "Master Drive", 1.0f, 25.0f, 1.0f);
-    juce::StringArray satModes{ "Soft Tanh", "Hard Clip", "Triode", "Tape", "Transformer", "JFET", "BJT", "Wavefold", "Bitcrush", "Exciter", "Cubic" };
-    params.push_back(std::make_unique<juce::AudioParameterChoice>("satType", "Saturation Mode", satModes, 0));
-    createFloat("masterOut", "Final Volume", 0.0f, 1.0f, 0.7f);
-    createFloat("masterWidth", "Stereo Width", 0.0f, 1.0f, 1.0f);
-    createFloat("masterRelease", "Note Safety Tail", 3.00f, 20.0f, 5.0f);
-    createFloat("masterPhase", "Global Phase Reset", 0.0f, 360.0f, 0.0f);
-    createFloat("limThreshold", "Limiter Threshold (dB)", -12.0f, 0.0f, 0.0f);
-    createFloat("limLookahead", "Limiter Look-ahead (ms)", 0.0f, 5.0f, 1.0f);
-    createFloat("masterLPF", "Master LowPass", 60.0f, 20000.0f, 20000.0f);
-
-    juce::StringArray osModes{ "Off", "2x (Standard)", "4x (High)", "8x (Ultra)" };
-    params.push_back(std::make_unique<juce::AudioParameterChoice>("osMode", "Oversampling", osModes, 1));
+    for (const auto& spec : paramTable) {
+        switch (spec.type) {
+        case ParamType::Choice:
+            params.push_back(std::make_unique<juce::AudioParameterChoice>(spec.id, spec.name, juce::StringArray(spec.choices, spec.numChoices), (int)spec.def));
+            break;
+        case ParamType::Bool:
+            params.push_back(std::make_unique<juce::AudioParameterBool>(spec.id, spec.name, spec.def > 0.5f));
+            break;
+        case ParamType::Float:
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(spec.id, spec.name, juce::NormalisableRange<float>(spec.min, spec.max, spec.interval, spec.skew), spec.def));
+            break;
+        }
+    }
 
     return { params.begin(), params.end() };
 }
@@ -84,16 +86,16 @@ void NextGenKickAudioProcessor::initPresets() {
         int bw, float bl, float ps, float pe, float pd, float pc, float pg, float bd, float bc, float bf,
         bool st, float sn, float sl, float sd, float sc,
         int sat, float dr, float mo, float mw, float mlpf) {
+            // Everything not listed keeps its table default (pans centred, pulse width 0.5, Bessel ratio 1.593, 2x OS, ...)
             PresetData p;
             p.name = n;
-            p.atkWave = aw; p.atkLevel = al; p.atkDecay = ad; p.atkCurve = ac; p.atkTone = at; p.atkHPF = ah; p.atkPan = 0;
-            p.atkPitch = ap;
-            p.atkPW = 0.5f;
-            p.bodyWave = bw; p.bodyLevel = bl; p.pStart = ps; p.pEnd = pe; p.pDecay = pd; p.pCurve = pc; p.pGlide = pg; p.bDecay = bd; p.bCurve = bc; p.bRatio = 1.593f; p.bFilter = bf; p.bPan = 0;
-            p.subTrack = st; p.subNote = sn; p.subFine = 0; p.subLevel = sl; p.subDecay = sd; p.subCurve = sc; p.subPhase = 0; p.subAntiClick = 5.0f; p.subPan = 0;
-            p.satType = sat; p.osMode = 1;
-            p.mDrive = dr; p.mOut = mo; p.mWidth = mw; p.mRelease = 5.0f; p.mPhase = 0; p.limThresh = 0; p.limLook = 1.0f;
-            p.mLPF = mlpf;
+            p[pAtkWave] = (float)aw; p[pAtkLevel] = al; p[pAtkDecay] = ad; p[pAtkCurve] = ac; p[pAtkTone] = at; p[pAtkHPF] = ah;
+            p[pAtkPitch] = ap;
+            p[pBodyWave] = (float)bw; p[pBodyLevel] = bl; p[pPStart] = ps; p[pPEnd] = pe; p[pPDecay] = pd; p[pPCurve] = pc; p[pPGlide] = pg; p[pBodyDecay] = bd; p[pBodyCurve] = bc; p[pBodyFilter] = bf;
+            p[pSubTrack] = st ? 1.0f : 0.0f; p[pSubNote] = sn; p[pSubLevel] = sl; p[pSubDecay] = sd; p[pSubCurve] = sc;
+            p[pSatType] = (float)sat;
+            p[pMasterDrive] = dr; p[pMasterOut] = mo; p[pMasterWidth] = mw;
+            p[pMasterLPF] = mlpf;
             presetList.push_back(p);
         };
 
@@ -248,66 +250,82 @@ void NextGenKickAudioProcessor::initPresets() {
     add("Test Tone", 0, 0.0f, 0.01f, 2.0f, 20000, 20, 3000, 0, 0.8f, 1000, 1000, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f, 20000, false, 0, 0.0f, 0.0f, 1.0f, 0, 1.0f, 0.5f, 0.6f, 20000.0f);
 }
 void NextGenKickAudioProcessor::loadPreset(int index) {
-    if (index < 0 || index >= presetList.size()) return;
+    if (index < 0 || index >= (int)presetList.size()) return;
     const auto& p = presetList[index];
 
-    auto setVal = [&](juce::String id, float val) {
-        if (auto* param = apvts.getParameter(id)) param->setValueNotifyingHost(param->convertTo0to1(val));
-        };
-
-    setVal("atkWave", (float)p.atkWave); setVal("atkLevel", p.atkLevel); setVal("atkDecay", p.atkDecay);
-    setVal("atkCurve", p.atkCurve); setVal("atkTone", p.atkTone); setVal("atkHPF", p.atkHPF);
-    setVal("atkPan", p.atkPan); setVal("atkPitch", p.atkPitch); setVal("atkPulseWidth", p.atkPW);
-
-    setVal("bodyWave", (float)p.bodyWave); setVal("bodyLevel", p.bodyLevel); setVal("pStart", p.pStart);
-    setVal("pEnd", p.pEnd); setVal("pDecay", p.pDecay); setVal("pCurve", p.pCurve);
-    setVal("pGlide", p.pGlide); setVal("bodyDecay", p.bDecay); setVal("bodyCurve", p.bCurve);
-    setVal("besselRatio", p.bRatio); setVal("bodyFilter", p.bFilter); setVal("bodyPan", p.bPan);
+    ParameterBatch batch;
+    for (int id = 0; id < numParams; ++id)
+        if (paramTable[(size_t)id].inPreset) batch.set((ParamId)id, p.values[(size_t)id]);
 
-    setVal("subTrack", p.subTrack ? 1.0f : 0.0f); setVal("subNote", p.subNote); setVal("subFine", p.subFine);
-    setVal("subLevel", p.subLevel); setVal("subDecay", p.subDecay); setVal("subCurve", p.subCurve);
-    setVal("subPhase", p.subPhase); setVal("subAntiClick", p.subAntiClick); setVal("subPan", p.subPan);
-    // subMode removed
-
-    setVal("satType", (float)p.satType); setVal("osMode", (float)p.osMode);
-    setVal("masterDrive", p.mDrive); setVal("masterOut", p.mOut); setVal("masterWidth", p.mWidth);
-    setVal("masterRelease", p.mRelease); setVal("masterPhase", p.mPhase);
-    setVal("limThreshold", p.limThresh); setVal("limLookahead", p.limLook);
-    setVal("masterLPF", p.mLPF);
+    applyParameterBatch(batch, "Preset: " + p.name);
 }
 
 void NextGenKickAudioProcessor::performRandomization() {
-    auto setVal = [&](juce::String id, float val) {
-        if (auto* param = apvts.getParameter(id)) param->setValueNotifyingHost(param->convertTo0to1(val));
-        };
+    ParameterBatch batch;
+    auto setVal = [&](ParamId param, float val) { batch.set(param, val); };
     auto randF = [&](float min, float max) { return min + random.nextFloat() * (max - min); };
     auto randI = [&](int min, int max) { return random.nextInt(max - min + 1) + min; };
 
-    setVal("atkWave", (float)randI(0, 7));
-    setVal("atkLevel", randF(0.2f, 0.8f));
-    setVal("atkDecay", randF(0.005f, 0.08f));
-    setVal("atkCurve", randF(0.5f, 4.0f));
-    setVal("atkTone", randF(5000.0f, 20000.0f));
-    setVal("atkHPF", randF(20.0f, 500.0f));
-    setVal("atkPitch", randF(500.0f, 8000.0f));
-
-    setVal("bodyWave", (float)randI(0, 4));
-    setVal("pStart", randF(200.0f, 1000.0f));
-    setVal("pEnd", randF(30.0f, 60.0f));
-    setVal("pDecay", randF(0.05f, 0.3f));
-    setVal("pCurve", randF(0.5f, 3.0f));
-    setVal("bodyDecay", randF(0.2f, 0.8f));
-    setVal("bodyLevel", randF(0.6f, 0.9f));
-    setVal("besselRatio", randF(1.0f, 2.5f));
-    setVal("bodyFilter", randF(2000.0f, 12000.0f));
-
-    setVal("subLevel", randF(0.4f, 0.8f));
-    setVal("subDecay", randF(0.2f, 0.6f));
-    setVal("subAntiClick", randF(1.0f, 10.0f));
-
-    setVal("satType", (float)randI(0, 10));
-    setVal("masterDrive", randF(1.0f, 5.0f));
-    setVal("masterLPF", randF(800.0f, 20000.0f));
+    setVal(pAtkWave, (float)randI(0, 7));
+    setVal(pAtkLevel, randF(0.2f, 0.8f));
+    setVal(pAtkDecay, randF(0.005f, 0.08f));
+    setVal(pAtkCurve, randF(0.5f, 4.0f));
+    setVal(pAtkTone, randF(5000.0f, 20000.0f));
+    setVal(pAtkHPF, randF(20.0f, 500.0f));
+    setVal(pAtkPitch, randF(500.0f, 8000.0f));
+
+    setVal(pBodyWave, (float)randI(0, 4));
+    setVal(pPStart, randF(200.0f, 1000.0f));
+    setVal(pPEnd, randF(30.0f, 60.0f));
+    setVal(pPDecay, randF(0.05f, 0.3f));
+    setVal(pPCurve, randF(0.5f, 3.0f));
+    setVal(pBodyDecay, randF(0.2f, 0.8f));
+    setVal(pBodyLevel, randF(0.6f, 0.9f));
+    setVal(pBesselRatio, randF(1.0f, 2.5f));
+    setVal(pBodyFilter, randF(2000.0f, 12000.0f));
+
+    setVal(pSubLevel, randF(0.4f, 0.8f));
+    setVal(pSubDecay, randF(0.2f, 0.6f));
+    setVal(pSubAntiClick, randF(1.0f, 10.0f));
+
+    setVal(pSatType, (float)randI(0, 10));
+    setVal(pMasterDrive, randF(1.0f, 5.0f));
+    setVal(pMasterLPF, randF(800.0f, 20000.0f));
+
+    applyParameterBatch(batch, "Randomize");
+}
+
+// Message thread
+void NextGenKickAudioProcessor::applyParameterBatch(const ParameterBatch& batch, const juce::String& transactionName) {
+    if (!useBatchedParameterChanges.load(std::memory_order_relaxed)) {
+        // The path this replaced, as it was: a string lookup per value, in call order, each notified on its own
+        auto setVal = [&](juce::String id, float val) {
+            if (auto* param = apvts.getParameter(id)) param->setValueNotifyingHost(param->convertTo0to1(val));
+            };
+        for (int i = 0; i < batch.numSet; ++i)
+            setVal(paramTable[(size_t)batch.order[(size_t)i]].id, batch.values[(size_t)batch.order[(size_t)i]]);
+        return;
+    }
+
+    // Only values that move, compared in the normalized form the host sees
+    std::array<float, numParams> normalized{};
+    std::bitset<numParams> changed;
+    for (int p = 0; p < numParams; ++p) {
+        auto* param = paramObjects[(size_t)p];
+        if (!batch.used[(size_t)p]) continue;
+        normalized[(size_t)p] = param->convertTo0to1(batch.values[(size_t)p]);
+        if (normalized[(size_t)p] != param->getValue()) changed.set((size_t)p);
+    }
+    if (changed.none()) return;
+
+    // The tree picks the values up on its next flush, inside this transaction; knob edits start their own
+    undoManager.beginNewTransaction(transactionName);
+    for (int p = 0; p < numParams; ++p)
+        if (changed[(size_t)p]) paramObjects[(size_t)p]->beginChangeGesture();
+    for (int p = 0; p < numParams; ++p)
+        if (changed[(size_t)p]) paramObjects[(size_t)p]->setValueNotifyingHost(normalized[(size_t)p]);
+    for (int p = 0; p < numParams; ++p)
+        if (changed[(size_t)p]) paramObjects[(size_t)p]->endChangeGesture();
 }
 
 void NextGenKickAudioProcessor::saveUserPreset(const juce::File& file) {
@@ -322,6 +340,8 @@ void NextGenKickAudioProcessor::loadUserPreset(const juce::File& file) {
         apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
 }
 
+// -sin(phase) for phase in [0, 2 pi). Folded once, so the Bessel partials (phase * ratio) keep the
+// values they always had, including the polynomial's growth past the fold for ratios above 2.
 inline double NextGenKickAudioProcessor::generateUltraPureSine(double phase) noexcept {
     double x = phase - juce::MathConstants<double>::pi;
     if (x < -juce::MathConstants<double>::pi) x += juce::MathConstants<double>::twoPi;
@@ -330,25 +350,44 @@ inline double NextGenKickAudioProcessor::generateUltraPureSine(double phase) noe
     return x * (1.0 - x2 * (0.1666666667 - x2 * (0.0083333333 - x2 * (0.0001984127 - x2 * (0.0000027557 - x2 * 0.0000000209)))));
 }
 
-inline double NextGenKickAudioProcessor::polyBlep(double t, double dt) noexcept {
-    if (t < dt) { t /= dt; return t + t - t * t - 1.0; }
-    else if (t > 1.0 - dt) { t = (t - 1.0) / dt; return t * t + t + t + 1.0; }
-    return 0.0;
+// Shared by the live voice loop and the stem renderer, so both produce the same samples.
+// Saw and square read the band-limited tables; a pulse is the difference of two saws.
+inline double NextGenKickAudioProcessor::atkOscillator(const WavetableBank& tables, int aWav, juce::uint32 phase, double dtA, float pulseWidth) noexcept {
+    const double t = LayerOscillatorCore::toCycles(phase);
+    const auto mip = WavetableBank::mipFor(dtA);
+    if (aWav == 3) return tables.read(WavetableBank::square, t, mip);
+    if (aWav == 4) return tables.read(WavetableBank::saw, t, mip);
+    if (aWav == 5) return std::abs(t - 0.5) * 4.0 - 1.0;
+    if (aWav == 6) {
+        const double t2 = t < (double)pulseWidth ? t - (double)pulseWidth + 1.0 : t - (double)pulseWidth;
+        return (2.0 * pulseWidth - 1.0) - (tables.read(WavetableBank::saw, t, mip) - tables.read(WavetableBank::saw, t2, mip));
+    }
+    return LayerOscillatorCore::sine(phase);
 }
 
-float NextGenKickAudioProcessor::getPinkNoise() noexcept {
-    const float w = random.nextFloat() * 2.0f - 1.0f;
-    b0 = 0.99886f * b0 + w * 0.0555179f; b1 = 0.99332f * b1 + w * 0.0750312f; b2 = 0.96900f * b2 + w * 0.1538520f;
-    b3 = 0.86650f * b3 + w * 0.3104856f; b4 = 0.55000f * b4 + w * 0.5329522f; b5 = -0.7616f * b5 + w * 0.0168980f;
-    const float p = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * 0.5362f) * 0.11f; b6 = w * 0.11592f; return p;
+// Bessel: each partial restarts with the fundamental's cycle, as it always has
+inline double NextGenKickAudioProcessor::bodyOscillator(const WavetableBank& tables, int bWav, juce::uint32 phase, double dtB, float besselRatio) noexcept {
+    if (bWav == bodySineWave) return LayerOscillatorCore::sine(phase);
+    const double t = LayerOscillatorCore::toCycles(phase);
+    if (bWav == 1) {
+        const double ph = t * juce::MathConstants<double>::twoPi;
+        return (generateUltraPureSine(ph) + 0.4 * generateUltraPureSine(ph * besselRatio) + 0.2 * generateUltraPureSine(ph * 2.135)) / 1.7;
+    }
+    if (bWav == 4) return std::abs(t - 0.5) * 4.0 - 1.0;
+    const auto mip = WavetableBank::mipFor(dtB);
+    if (bWav == 2) return tables.read(WavetableBank::saw, t, mip);
+    return tables.read(WavetableBank::square, t, mip);
 }
 
 // --- ADAA (Antiderivative Antialiasing) Calculation ---
+// Type >= 0 fixes the curve at compile time; -1 selects it from `type` at run time (generic path).
+// Fast swaps the transcendental calls for the bounded approximations in FastMath.h.
+template <int Type, bool Fast>
 inline float NextGenKickAudioProcessor::calcADAAFunc(float x, int type) noexcept {
-    switch (type) {
+    using M = SaturationMath<Fast>;
+    switch (Type >= 0 ? Type : type) {
     case 0: // Soft Tanh
-        if (std::abs(x) > 10.0f) return std::abs(x) - 0.693147f;
-        return std::log(std::cosh(x));
+        return M::logCosh(x);
 
     case 1: // Hard Clip
         if (x < -1.0f) return -x - 0.5f;
@@ -359,14 +398,14 @@ inline float NextGenKickAudioProcessor::calcADAAFunc(float x, int type) noexcept
     {
         const float k = 2.2f;
         const float scale = 0.58f;
-        float term1 = x * std::atan(k * x);
-        float term2 = (0.5f / k) * std::log(1.0f + k * k * x * x);
+        float term1 = x * M::atan(k * x);
+        float term2 = (0.5f / k) * M::log1p(k * k * x * x);
         return scale * (term1 - term2);
     }
 
     case 7: // Wavefold
     {
-        return -1.0f / juce::MathConstants<float>::pi * std::cos(x * juce::MathConstants<float>::pi);
+        return -1.0f / juce::MathConstants<float>::pi * M::cosPi(x);
     }
 
     case 10: // Cubic
@@ -376,16 +415,14 @@ inline float NextGenKickAudioProcessor::calcADAAFunc(float x, int type) noexcept
     }
 }
 
-float NextGenKickAudioProcessor::processSaturationSampleADAA(float x, int type, float drive, SaturationState& state) {
-    if (drive <= 1.001f) {
-        state.active = false;
-        state.lastX = x;
-        return x;
-    }
+template <int Type, bool Fast>
+inline float NextGenKickAudioProcessor::saturateDriven(float x, int runtimeType, float drive, SaturationState& state) noexcept {
+    using M = SaturationMath<Fast>;
+    const int type = Type >= 0 ? Type : runtimeType;
 
     if (type == 3) {
         float g = x * drive;
-        float y = 0.92f * std::tanh(g + 0.08f * state.tapeHysteresis);
+        float y = 0.92f * M::tanh(g + 0.08f * state.tapeHysteresis);
         state.tapeHysteresis = y;
         return y;
     }
@@ -397,7 +434,7 @@ float NextGenKickAudioProcessor::processSaturationSampleADAA(float x, int type,
         case 4: return g / (1.0f + 0.45f * std::abs(g));
         case 5: return (std::abs(g) < 1.0f) ? g - (g * g * g) / 3.0f : (g > 0 ? 0.67f : -0.67f);
         case 8: { float step = 1.0f / (1.0f + (25.0f - drive)); return std::round(g / step) * step; }
-        case 9: { float hpf = g - 0.96f * g; return g + 0.45f * std::tanh(hpf * 9.0f); }
+        case 9: { float hpf = g - 0.96f * g; return g + 0.45f * M::tanh(hpf * 9.0f); }
         default: return g;
         }
     }
@@ -407,27 +444,27 @@ float NextGenKickAudioProcessor::processSaturationSampleADAA(float x, int type,
     if (!state.active) {
         state.active = true;
         state.lastX = g;
-        state.lastF = calcADAAFunc(g, type);
+        state.lastF = calcADAAFunc<Type, Fast>(g, type);
 
         switch (type) {
-        case 0: return std::tanh(g);
+        case 0: return M::tanh(g);
         case 1: return juce::jlimit(-1.0f, 1.0f, g);
-        case 6: return std::atan(g * 2.2f) * 0.58f;
-        case 7: return std::sin(g * juce::MathConstants<float>::pi);
+        case 6: return M::atan(g * 2.2f) * 0.58f;
+        case 7: return M::sinPi(g);
         case 10: return g - (g * g * g) / 3.1f;
         }
     }
 
-    float Fx = calcADAAFunc(g, type);
+    float Fx = calcADAAFunc<Type, Fast>(g, type);
     float output = 0.0f;
     float delta = g - state.lastX;
 
     if (std::abs(delta) < 1.0e-5f) {
         switch (type) {
-        case 0: output = std::tanh(g); break;
+        case 0: output = M::tanh(g); break;
         case 1: output = juce::jlimit(-1.0f, 1.0f, g); break;
-        case 6: output = std::atan(g * 2.2f) * 0.58f; break;
-        case 7: output = std::sin(g * juce::MathConstants<float>::pi); break;
+        case 6: output = M::atan(g * 2.2f) * 0.58f; break;
+        case 7: output = M::sinPi(g); break;
         case 10: output = g - (g * g * g) / 3.1f; break;
         }
     }
@@ -441,251 +478,602 @@ float NextGenKickAudioProcessor::processSaturationSampleADAA(float x, int type,
     return output;
 }
 
-void NextGenKickAudioProcessor::updateOversampler(int mode, int samplesPerBlock) {
-    std::lock_guard<std::mutex> lock(oversamplerMutex);
+template <int Type, bool Fast>
+void NextGenKickAudioProcessor::saturateBlock(float* p, int numSamples, int type, float drive, SaturationState& state) noexcept {
+    if (numSamples <= 0) return;
 
-    if (mode <= 0) {
-        oversampler.reset();
+    // Drive is block-constant, so the bypass test is hoisted out of the loop
+    if (drive <= 1.001f) {
+        state.active = false;
+        state.lastX = p[numSamples - 1];
+        return;
     }
-    else {
-        // mode 1=2x(factor=1), 2=4x(factor=2), 3=8x(factor=3)
-        oversampler = std::make_unique<juce::dsp::Oversampling<float>>(2, mode, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-        oversampler->initProcessing(samplesPerBlock);
-        oversampler->reset();
+    for (int i = 0; i < numSamples; ++i) p[i] = saturateDriven<Type, Fast>(p[i], type, drive, state);
+}
+
+// --- Kernel Dispatch Tables ---
+template <size_t... I>
+std::array<NextGenKickAudioProcessor::RenderKernel, sizeof...(I)> NextGenKickAudioProcessor::makeRenderKernels(std::index_sequence<I...>) {
+    return { { &NextGenKickAudioProcessor::renderSpan<(int)(I / numBodyWaves), (int)(I % numBodyWaves)>... } };
+}
+
+template <bool Fast, size_t... I>
+std::array<NextGenKickAudioProcessor::SaturationKernel, sizeof...(I)> NextGenKickAudioProcessor::makeSaturationKernels(std::index_sequence<I...>) {
+    return { { &NextGenKickAudioProcessor::saturateBlock<(int)I, Fast>... } };
+}
+
+void NextGenKickAudioProcessor::selectKernels(int aWav, int bWav, int satType) {
+    const bool fast = useFastSaturationMath.load();
+
+    // Generic reference path: waveforms and saturation type re-dispatched on every sample
+    if (!useSpecializedKernels.load()) {
+        renderKernel = &NextGenKickAudioProcessor::renderSpan<-1, -1>;
+        saturationKernel = fast ? &NextGenKickAudioProcessor::saturateBlock<-1, true> : &NextGenKickAudioProcessor::saturateBlock<-1, false>;
+        return;
     }
-    // Latency is now updated in updateLatency() called from processBlock
+
+    static const auto renderKernels = makeRenderKernels(std::make_index_sequence<numAtkWaves * numBodyWaves>());
+    static const auto exactSaturationKernels = makeSaturationKernels<false>(std::make_index_sequence<numSatTypes>());
+    static const auto fastSaturationKernels = makeSaturationKernels<true>(std::make_index_sequence<numSatTypes>());
+    renderKernel = renderKernels[(size_t)(juce::jlimit(0, numAtkWaves - 1, aWav) * numBodyWaves + juce::jlimit(0, numBodyWaves - 1, bWav))];
+    saturationKernel = (fast ? fastSaturationKernels : exactSaturationKernels)[(size_t)juce::jlimit(0, numSatTypes - 1, satType)];
 }
 
-void NextGenKickAudioProcessor::updateLatency(int lookaheadSamples) {
-    int osLatency = 0;
-    {
-        std::lock_guard<std::mutex> lock(oversamplerMutex);
-        if (oversampler) osLatency = (int)oversampler->getLatencyInSamples();
+void NextGenKickAudioProcessor::prepareOversamplers(int maxBlockSize) {
+    // mode 1=2x(factor=1), 2=4x(factor=2), 3=8x(factor=3); mode 0 (Off) has no oversampler
+    for (int mode = 1; mode < numOsModes; ++mode) {
+        oversamplers[(size_t)mode] = std::make_unique<juce::dsp::Oversampling<float>>(2, mode, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+        oversamplers[(size_t)mode]->initProcessing((size_t)maxBlockSize);
+        oversamplers[(size_t)mode]->reset();
     }
+}
+
+// Audio thread: no locks, no allocation. The outgoing mode keeps running for osFadeLength samples
+void NextGenKickAudioProcessor::switchOversampler(int mode) {
+    fadeOsMode = currentOsMode;
+    fadeSatStates = satStates;
+    osFadePos = 0;
 
-    int totalLatency = osLatency + lookaheadSamples;
+    currentOsMode = mode;
+    if (auto* os = oversamplers[(size_t)mode].get()) os->reset();
+    for (auto& s : satStates) s.reset();
+}
 
-    if (totalLatency != currentReportedLatency) {
-        currentReportedLatency = totalLatency;
-        setLatencySamples(totalLatency);
+void NextGenKickAudioProcessor::saturateOversampled(int mode, juce::dsp::AudioBlock<float> block, std::array<SaturationState, 2>& states, int satType) {
+    if (auto* os = oversamplers[(size_t)mode].get()) {
+        auto upsampledBlock = os->processSamplesUp(block);
+        for (int ch = 0; ch < 2; ++ch)
+            (this->*saturationKernel)(upsampledBlock.getChannelPointer((size_t)ch), (int)upsampledBlock.getNumSamples(), satType, masterDriveVal, states[(size_t)ch]);
+        os->processSamplesDown(block);
+    }
+    else {
+        for (int ch = 0; ch < 2; ++ch)
+            (this->*saturationKernel)(block.getChannelPointer((size_t)ch), (int)block.getNumSamples(), satType, masterDriveVal, states[(size_t)ch]);
     }
 }
 
+int NextGenKickAudioProcessor::getLookaheadSamples() const noexcept {
+    const int lookaheadSamples = std::max(0, (int)(blockParam(bpLimLookahead) * 0.001f * currentSampleRate));
+    return std::min(lookaheadSamples, limBufferSize - 2 - TruePeakInterpolator::delay);
+}
+
+int NextGenKickAudioProcessor::computeLatency(int lookaheadSamples, bool truePeak) const noexcept {
+    // Always the active mode: a crossfade hands over to its latency immediately
+    int osLatency = 0;
+    if (auto* os = oversamplers[(size_t)currentOsMode].get()) osLatency = (int)os->getLatencyInSamples();
+    const int truePeakLatency = truePeak ? TruePeakInterpolator::delay : 0;
+    return osLatency + lookaheadSamples + truePeakLatency;
+}
+
+// Message thread
+void NextGenKickAudioProcessor::timerCallback() {
+    const int latency = pendingLatency.load();
+    if (latency != getLatencySamples()) setLatencySamples(latency);
+}
+
 bool NextGenKickAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::mono() || layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+    const auto mainOut = layouts.getMainOutputChannelSet();
+    if (mainOut != juce::AudioChannelSet::mono() && mainOut != juce::AudioChannelSet::stereo()) return false;
+
+    // Layer buses: off or stereo
+    for (int bus = 1; bus < (int)layouts.outputBuses.size(); ++bus) {
+        const auto set = layouts.getChannelSet(false, bus);
+        if (!set.isDisabled() && set != juce::AudioChannelSet::stereo()) return false;
+    }
+    return true;
 }
 
 void NextGenKickAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     currentSampleRate = (float)sampleRate;
+    previewSampleRate = currentSampleRate;
     isNoteActive = false;
     std::fill(limBufferL.begin(), limBufferL.end(), 0.0f);
     std::fill(limBufferR.begin(), limBufferR.end(), 0.0f);
     dcLastInL = dcLastOutL = dcLastInR = dcLastOutR = 0;
-    cachedPeak = 0.0f; cachedPeakIdx = -1;
-    crCounter = 0;
+    limPeakWindow.reset();
+    for (auto& ring : layerRing) std::fill(ring.begin(), ring.end(), 0.0f);
+    lastLayerMix.fill(0.0f);
+    layerDcIn.fill(0.0f);
+    layerDcOut.fill(0.0f);
+    quietSamples = 0;
+    chainIdle = false;
+    meterStream.prepare(sampleRate);
+    if (const auto seed = noiseSeed.load(); seed != 0) noise = NoiseGenerator(seed);
+
+    // Voice pool and its scratch lanes are sized here, never on the audio thread
+    voices.prepare(sampleRate);
+    for (auto* v : { &voiceAtk, &voiceBody, &voiceSub }) v->assign(KickVoicePool::maxSlots, 0.0f);
+    voiceDone.assign(KickVoicePool::maxSlots, 0);
+    noiseBlock.assign((size_t)(internalChunkSize * KickVoicePool::maxSlots), 0.0f);
 
     for (auto& s : satStates) s.reset();
 
-    satBuffer.setSize(2, samplesPerBlock);
-
-    // Initial OS setup
-    currentOsMode = (int)apvts.getRawParameterValue("osMode")->load();
-    updateOversampler(currentOsMode, samplesPerBlock);
+    // The whole post-voice chain runs per chunk, whatever the host block size
+    juce::ignoreUnused(samplesPerBlock);
+    satBuffer.setSize(2, internalChunkSize);
+    osFadeBuffer.setSize(2, internalChunkSize);
+    layerBuffer.setSize(numLayerChannels, internalChunkSize);
+    monoFoldBuffer.assign((size_t)internalChunkSize, 0.0f);
 
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
+    // Every OS factor is built here, so mode changes never allocate on the audio thread
+    prepareOversamplers(internalChunkSize);
+    currentOsMode = juce::jlimit(0, numOsModes - 1, (int)blockParam(bpOsMode));
+    fadeOsMode = -1;
+    osFadeLength = juce::jmax(1, (int)(osFadeSeconds * sampleRate));
 
-    filterAtkHP.prepare(spec); filterAtkHP.setType(juce::dsp::StateVariableTPTFilterType::highpass); filterAtkHP.setResonance(0.5f);
-    filterAtkLP.prepare(spec); filterAtkLP.setType(juce::dsp::StateVariableTPTFilterType::lowpass); filterAtkLP.setResonance(0.5f);
-    filterBodyLP.prepare(spec); filterBodyLP.setType(juce::dsp::StateVariableTPTFilterType::lowpass); filterBodyLP.setResonance(0.5f);
+    coefAtkHP.update(parameterValue(pAtkHPF), currentSampleRate);
+    coefAtkLP.update(parameterValue(pAtkTone), currentSampleRate);
+    coefBodyLP.update(parameterValue(pBodyFilter), currentSampleRate);
 
     // Master LPF Init (4-stage cascade)
-    for (auto& f : filterMasterLP_L) { f.prepare(spec); f.setType(juce::dsp::StateVariableTPTFilterType::lowpass); f.setResonance(0.5f); }
-    for (auto& f : filterMasterLP_R) { f.prepare(spec); f.setType(juce::dsp::StateVariableTPTFilterType::lowpass); f.setResonance(0.5f); }
-
-    double smoothTime = 0.02;
-    s_atkDecay.reset(sampleRate, smoothTime); s_atkCurve.reset(sampleRate, smoothTime); s_atkTone.reset(sampleRate, smoothTime);
-    s_atkLevel.reset(sampleRate, smoothTime); s_atkPan.reset(sampleRate, smoothTime); s_atkPitch.reset(sampleRate, smoothTime);
-    s_atkHPF.reset(sampleRate, smoothTime); s_atkPW.reset(sampleRate, smoothTime);
-    s_pStart.reset(sampleRate, smoothTime); s_pEnd.reset(sampleRate, smoothTime); s_pDecay.reset(sampleRate, smoothTime);
-    s_pGlide.reset(sampleRate, smoothTime); s_pCurve.reset(sampleRate, smoothTime); s_bodyDecay.reset(sampleRate, smoothTime);
-    s_bodyCurve.reset(sampleRate, smoothTime); s_bodyLevel.reset(sampleRate, smoothTime); s_bodyPan.reset(sampleRate, smoothTime);
-    s_besselRatio.reset(sampleRate, smoothTime); s_bodyFilter.reset(sampleRate, smoothTime);
-    s_subNote.reset(sampleRate, smoothTime); s_subFine.reset(sampleRate, smoothTime); s_subDecay.reset(sampleRate, smoothTime);
-    s_subCurve.reset(sampleRate, smoothTime); s_subLevel.reset(sampleRate, smoothTime); s_subPhase.reset(sampleRate, smoothTime);
-    s_subAntiClick.reset(sampleRate, smoothTime); s_subPan.reset(sampleRate, smoothTime);
-    s_masterDrive.reset(sampleRate, smoothTime); s_masterOut.reset(sampleRate, smoothTime); s_masterWidth.reset(sampleRate, smoothTime);
-    s_masterRelease.reset(sampleRate, smoothTime); s_masterPhase.reset(sampleRate, smoothTime); s_limThreshold.reset(sampleRate, smoothTime);
-    s_masterLPF.reset(sampleRate, smoothTime);
+    masterLowpass.prepare(sampleRate);
+    for (auto& lp : layerLowpass) lp.prepare(sampleRate);
 
+    // Targets first, so the resets below snap every smoother to the current values
     updateParameters();
+
+    for (int p = 0; p < numVoiceParams; ++p) voiceParams[(size_t)p].prepare(sampleRate, paramSpec(voiceParamSources[p]).smoothingSeconds, internalChunkSize);
+    s_subPhase.reset(sampleRate, paramSpec(pSubPhase).smoothingSeconds);
+    s_masterWidth.reset(sampleRate, paramSpec(pMasterWidth).smoothingSeconds);
+    s_masterPhase.reset(sampleRate, paramSpec(pMasterPhase).smoothingSeconds);
+
+    masterDriveVal = voiceParams[vpMasterDrive].getTargetValue(); masterOutVal = voiceParams[vpMasterOut].getTargetValue();
+    limThresholdDB = voiceParams[vpLimThreshold].getTargetValue(); masterLPFVal = voiceParams[vpMasterLPF].getTargetValue();
+
+    // Not the audio thread yet: report latency directly and build the kernel tables
+    pendingLatency = computeLatency(getLookaheadSamples(), blockParam(bpLimTruePeak) > 0.5f);
+    setLatencySamples(pendingLatency.load());
+    selectKernels((int)blockParam(bpAtkWave), (int)blockParam(bpBodyWave), (int)blockParam(bpSatType));
 }
 
-void NextGenKickAudioProcessor::updateParameters() {
-    auto getRaw = [this](juce::String id) { return apvts.getRawParameterValue(id)->load(); };
-    s_atkDecay.setTargetValue(getRaw("atkDecay")); s_atkCurve.setTargetValue(getRaw("atkCurve")); s_atkTone.setTargetValue(getRaw("atkTone"));
-    s_atkLevel.setTargetValue(getRaw("atkLevel")); s_atkPan.setTargetValue(getRaw("atkPan")); s_atkPitch.setTargetValue(getRaw("atkPitch"));
-    s_atkHPF.setTargetValue(getRaw("atkHPF")); s_atkPW.setTargetValue(getRaw("atkPulseWidth"));
-    s_pStart.setTargetValue(getRaw("pStart")); s_pEnd.setTargetValue(getRaw("pEnd")); s_pDecay.setTargetValue(getRaw("pDecay"));
-    s_pGlide.setTargetValue(getRaw("pGlide")); s_pCurve.setTargetValue(getRaw("pCurve")); s_bodyDecay.setTargetValue(getRaw("bodyDecay"));
-    s_bodyCurve.setTargetValue(getRaw("bodyCurve")); s_bodyLevel.setTargetValue(getRaw("bodyLevel")); s_bodyPan.setTargetValue(getRaw("bodyPan"));
-    s_besselRatio.setTargetValue(getRaw("besselRatio")); s_bodyFilter.setTargetValue(getRaw("bodyFilter"));
-    s_subNote.setTargetValue(getRaw("subNote")); s_subFine.setTargetValue(getRaw("subFine")); s_subDecay.setTargetValue(getRaw("subDecay"));
-    s_subCurve.setTargetValue(getRaw("subCurve")); s_subLevel.setTargetValue(getRaw("subLevel")); s_subPhase.setTargetValue(getRaw("subPhase"));
-    s_subAntiClick.setTargetValue(getRaw("subAntiClick")); s_subPan.setTargetValue(getRaw("subPan"));
-    s_masterDrive.setTargetValue(getRaw("masterDrive")); s_masterOut.setTargetValue(getRaw("masterOut")); s_masterWidth.setTargetValue(getRaw("masterWidth"));
-    s_masterRelease.setTargetValue(getRaw("masterRelease")); s_masterPhase.setTargetValue(getRaw("masterPhase")); s_limThreshold.setTargetValue(getRaw("limThreshold"));
-    s_masterLPF.setTargetValue(getRaw("masterLPF"));
+void NextGenKickAudioProcessor::startVoice(int note, const VoiceBlockContext& ctx) {
+    const bool wasIdle = voices.numActive == 0;
+
+    const int v = voices.allocate(note, ctx.polyphony, ctx.stealMode);
+    const auto sPh = LayerOscillatorCore::phaseFromCycles(s_masterPhase.getTargetValue() / 360.0);
+    const auto subPh = LayerOscillatorCore::phaseFromCycles((s_subPhase.getTargetValue() + s_masterPhase.getTargetValue()) / 360.0);
+    voices.start(v, note, sPh, subPh, (float)(440.0 * std::pow(2.0, ((double)note - 69.0) / 12.0)));
+    if (useStemCache.load(std::memory_order_relaxed)) attachStems(v, ctx);
+    isNoteActive = true;
+
+    // Only a note out of silence resets the master chain; overlapping tails keep running through it
+    if (wasIdle) {
+        if (auto* os = oversamplers[(size_t)currentOsMode].get()) os->reset();
+        for (auto& s : satStates) s.reset();
+        fadeOsMode = -1;
+    }
 }
 
-void NextGenKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto numSamples = buffer.getNumSamples();
-    updateParameters();
+// Control rate: called once per chunk
+void NextGenKickAudioProcessor::updateParameters() {
+    for (int p = 0; p < numVoiceParams; ++p) voiceParams[(size_t)p].setTargetValue(voiceParamRaw[(size_t)p]->load());
+    s_subPhase.setTargetValue(parameterValue(pSubPhase)); s_masterWidth.setTargetValue(parameterValue(pMasterWidth)); s_masterPhase.setTargetValue(parameterValue(pMasterPhase));
+}
 
-    const double invSR = 1.0 / (double)currentSampleRate;
-    const double twoPi = juce::MathConstants<double>::twoPi;
-    const double invTwoPi = 1.0 / twoPi;
+// --- Stem Cache ---
+int NextGenKickAudioProcessor::stemLayerOf(int p) noexcept {
+    if (p == vpAtkLevel || p == vpAtkPan || p == vpBodyLevel || p == vpBodyPan || p == vpSubLevel || p == vpSubPan) return -1;
+    if (p <= vpAtkPW) return layerAtk;
+    if (p <= vpBodyFilter) return layerBody;
+    if (p <= vpSubPan) return layerSub;
+    return -1;
+}
 
-    const int sMod = (int)apvts.getRawParameterValue("satType")->load();
-    const int aWav = (int)apvts.getRawParameterValue("atkWave")->load();
-    const int bWav = (int)apvts.getRawParameterValue("bodyWave")->load();
-    const bool sTra = apvts.getRawParameterValue("subTrack")->load() > 0.5f;
-    const int newOsMode = (int)apvts.getRawParameterValue("osMode")->load();
+// FNV-1a over everything the layer's samples depend on
+juce::uint64 NextGenKickAudioProcessor::stemKey(const StemRequest& r) noexcept {
+    juce::uint64 h = 14695981039346656037ull;
+    auto add = [&h](auto value) {
+        const auto* bytes = reinterpret_cast<const juce::uint8*>(&value);
+        for (size_t i = 0; i < sizeof(value); ++i) { h ^= bytes[i]; h *= 1099511628211ull; }
+    };
+
+    add(r.layer); add(r.sampleRate);
+    if (r.layer == layerAtk) { add(r.aWav); add(r.startPhase); }
+    else if (r.layer == layerBody) { add(r.bWav); add(r.startPhase); }
+    else { add(r.subStartPhase); add(r.sTra); add(r.sTra ? r.note : 0); }
+
+    for (int p = 0; p < numVoiceParams; ++p)
+        if (stemLayerOf(p) == r.layer && !(p == vpSubNote && r.sTra)) add(r.params[(size_t)p]);
+    return h;
+}
 
-    if (newOsMode != currentOsMode) {
-        currentOsMode = newOsMode;
-        updateOversampler(currentOsMode, numSamples);
+// Render thread: one layer of one voice at level 1. Same arithmetic as renderSpan with every
+// parameter settled, so a voice playing the stem matches a live one to float rounding.
+void NextGenKickAudioProcessor::renderStem(const StemRequest& r, CachedStem& stem) {
+    static constexpr int silentRun = 64; // samples below -100 dB in a row end the stem for good
+
+    const auto& P = r.params;
+    const double invSR = 1.0 / r.sampleRate;
+    const juce::SharedResourcePointer<WavetableBank> tables; // the instances keep it alive, so this only counts a reference
+    const int maxLength = r.maxLength > 0 ? r.maxLength : (int)(CachedStem::maxSeconds * r.sampleRate);
+
+    stem.samples.reserve((size_t)maxLength);
+    stem.envelope.reserve((size_t)(maxLength / CachedStem::envelopeDecimation + 1));
+
+    auto& e = stem.end;
+    e.phase = r.layer == layerSub ? r.subStartPhase : r.startPhase;
+    int quiet = 0;
+
+    // Appends one sample; true once the layer has been silent for silentRun samples
+    auto append = [&](float y, float env, bool silent) {
+        if (stem.samples.size() % CachedStem::envelopeDecimation == 0) stem.envelope.push_back(env);
+        stem.samples.push_back(y);
+        quiet = silent ? quiet + 1 : 0;
+        return quiet >= silentRun;
+    };
+
+    if (r.layer == layerAtk) {
+        PowerDecayEnvelope env; env.setParameters(P[vpAtkDecay], P[vpAtkCurve], r.sampleRate);
+        TPTCoeffs hp, lp; hp.update(P[vpAtkHPF], (float)r.sampleRate); lp.update(P[vpAtkTone], (float)r.sampleRate);
+        PowerDecayEnvelope::start(e.envAtk);
+        const double dtA = (double)P[vpAtkPitch] * invSR;
+        const juce::uint32 incA = LayerOscillatorCore::increment(dtA);
+        double time = 0.0;
+        NoiseGenerator noise(1); // noise attacks are only rendered for the preview; a fixed seed keeps it steady
+        std::array<float, internalChunkSize> noiseChunk{};
+        int noisePos = internalChunkSize;
+
+        while (stem.length() < maxLength) {
+            const float envVal = env.tick(e.envAtk, time);
+            const bool finished = PowerDecayEnvelope::isFinished(e.envAtk);
+            if (!finished && r.aWav < 3 && noisePos == internalChunkSize) { noise.fill(r.aWav, noiseChunk.data(), internalChunkSize); noisePos = 0; }
+            const double raw = finished ? 0.0 : r.aWav < 3 ? (double)noiseChunk[(size_t)noisePos++] : atkOscillator(*tables, r.aWav, e.phase, dtA, P[vpAtkPW]);
+            const float x = finished ? 0.0f : (float)raw * envVal;
+            const float y = lp.processLowpass(hp.processHighpass(x, e.filter[0], e.filter[1]), e.filter[2], e.filter[3]);
+
+            e.phase += incA;
+            time += invSR;
+            if (append(y, envVal, finished && std::abs(y) < 1.0e-5f)) { stem.silentAfter = true; break; }
+        }
+    }
+    else if (r.layer == layerBody) {
+        ExpDecayEnvelope pitchEnv, bodyEnv;
+        pitchEnv.setParameters(P[vpPDecay], P[vpPCurve], r.sampleRate); bodyEnv.setParameters(P[vpBodyDecay], P[vpBodyCurve], r.sampleRate);
+        TPTCoeffs lp; lp.update(P[vpBodyFilter], (float)r.sampleRate);
+        ExpDecayEnvelope::start(e.envPitch); ExpDecayEnvelope::start(e.env);
+
+        while (stem.length() < maxLength) {
+            const float pE = pitchEnv.tick(e.envPitch);
+            const double fBody = (double)P[vpPEnd] + ((double)P[vpPStart] - (double)P[vpPEnd]) * (pE + P[vpPGlide] * (pE * pE * pE));
+            const double dtB = fBody * invSR;
+            const double bodyRaw = bodyOscillator(*tables, r.bWav, e.phase, dtB, P[vpBesselRatio]);
+            const float bodyEnvVal = bodyEnv.tick(e.env);
+            const float y = lp.processLowpass((float)bodyRaw * bodyEnvVal, e.filter[0], e.filter[1]);
+
+            e.phase += LayerOscillatorCore::increment(dtB);
+            if (append(y, bodyEnvVal, bodyEnvVal < 1.0e-5f && std::abs(y) < 1.0e-5f)) { stem.silentAfter = true; break; }
+        }
+    }
+    else {
+        ExpDecayEnvelope subEnv; RaisedCosineFade fade;
+        subEnv.setParameters(P[vpSubDecay], P[vpSubCurve], r.sampleRate); fade.setParameters(P[vpSubAntiClick], r.sampleRate);
+        ExpDecayEnvelope::start(e.env); RaisedCosineFade::start(e.fade);
+        const double baseHz = r.sTra ? (double)(float)(440.0 * std::pow(2.0, ((double)r.note - 69.0) / 12.0))
+                                     : 440.0 * std::pow(2.0, ((double)P[vpSubNote] - 69.0) / 12.0);
+        const juce::uint32 incS = LayerOscillatorCore::increment((baseHz + (double)P[vpSubFine]) * invSR);
+
+        while (stem.length() < maxLength) {
+            const float subEnvBase = subEnv.tick(e.env);
+            const float antiC = fade.tick(e.fade);
+            const float y = LayerOscillatorCore::sine(e.phase) * subEnvBase * antiC;
+
+            e.phase += incS;
+            if (append(y, subEnvBase, subEnvBase < 1.0e-5f)) { stem.silentAfter = true; break; }
+        }
     }
 
-    const float dcAlpha = std::exp(-(float)invSR * (1.0f / 0.075f));
-
-    float lookaheadMs = apvts.getRawParameterValue("limLookahead")->load();
-    int lookaheadSamples = std::max(0, (int)(lookaheadMs * 0.001f * currentSampleRate));
-    lookaheadSamples = std::min(lookaheadSamples, limBufferSize - 2);
+    // Most layers end well before maxSeconds
+    stem.samples.shrink_to_fit();
+    stem.envelope.shrink_to_fit();
+}
 
-    // Update reported latency (OS + Limiter)
-    updateLatency(lookaheadSamples);
+// Audio thread, at note-on: every layer whose parameters are settled plays its stem if one is
+// cached, otherwise it is synthesized live and the stem is queued for the next note
+void NextGenKickAudioProcessor::attachStems(int v, const VoiceBlockContext& ctx) {
+    StemRequest r;
+    static_assert(numVoiceParams <= StemRequest::maxParams, "StemRequest::params too small");
+    for (int p = 0; p < numVoiceParams; ++p) r.params[(size_t)p] = voiceParams[(size_t)p].getTargetValue();
+    r.aWav = ctx.aWav; r.bWav = ctx.bWav; r.sTra = ctx.sTra; r.note = voices.note[v];
+    r.sampleRate = (double)currentSampleRate;
+    r.startPhase = voices.phase(v, LayerOscillatorCore::laneAtk); r.subStartPhase = voices.phase(v, LayerOscillatorCore::laneSub);
+
+    for (int layer = 0; layer < numStemLayers; ++layer) {
+        if (layer == layerAtk && ctx.aWav < 3) continue; // noise is never the same twice
+
+        bool settled = true;
+        for (int p = 0; p < numVoiceParams; ++p)
+            if (stemLayerOf(p) == layer && voiceParams[(size_t)p].isSmoothing()) settled = false;
+        if (!settled) continue;
+
+        r.layer = layer;
+        r.key = stemKey(r);
+        if (const auto* stem = stemCache.acquire(layer, r.key)) voices.stems[(size_t)layer][v] = stem;
+        else stemCache.request(r);
+    }
+}
 
-    // --- MIDI Processing with Sample Accuracy ---
-    int triggerSample = -1;
-    for (const auto metadata : midiMessages) {
-        if (metadata.getMessage().isNoteOn()) {
-            triggerSample = metadata.samplePosition;
-            lastMidiNote = metadata.getMessage().getNoteNumber();
-            // Note: We don't reset state here, we do it inside the sample loop at triggerSample
+// Per sample, for voices with stems. A stem that ends before its layer is silent hands the
+// layer over to live synthesis; the filter states were rendered at level 1.
+void NextGenKickAudioProcessor::advanceStems(int v, float atkLevel, float bodyLevel) noexcept {
+    const int pos = ++voices.stemPos[v];
+    for (int layer = 0; layer < numStemLayers; ++layer) {
+        const CachedStem* stem = voices.stems[(size_t)layer][v];
+        if (stem == nullptr || pos != stem->length() || stem->silentAfter) continue;
+
+        const auto& e = stem->end;
+        if (layer == layerAtk) {
+            voices.phase(v, LayerOscillatorCore::laneAtk) = e.phase; voices.envAtk[v] = e.envAtk;
+            voices.atkHP1[v] = e.filter[0] * atkLevel; voices.atkHP2[v] = e.filter[1] * atkLevel;
+            voices.atkLP1[v] = e.filter[2] * atkLevel; voices.atkLP2[v] = e.filter[3] * atkLevel;
         }
+        else if (layer == layerBody) {
+            voices.phase(v, LayerOscillatorCore::laneBody) = e.phase; voices.envPitch[v] = e.envPitch; voices.envBody[v] = e.env;
+            voices.bodyLP1[v] = e.filter[0] * bodyLevel; voices.bodyLP2[v] = e.filter[1] * bodyLevel;
+        }
+        else {
+            voices.phase(v, LayerOscillatorCore::laneSub) = e.phase; voices.envSub[v] = e.env; voices.subFade[v] = e.fade;
+        }
+        CachedStem::release(stem);
+        voices.stems[(size_t)layer][v] = nullptr;
     }
+}
 
-    auto* satL = satBuffer.getWritePointer(0);
-    auto* satR = satBuffer.getWritePointer(1);
+// --- Static Preview ---
+// Preview thread: what a note-on would start with right now, read from the parameter atomics
+StemRequest NextGenKickAudioProcessor::takePreviewSnapshot() const {
+
+    StemRequest r;
+    for (int p = 0; p < numVoiceParams; ++p) r.params[(size_t)p] = voiceParamRaw[(size_t)p]->load();
+    r.aWav = (int)blockParam(bpAtkWave);
+    r.bWav = (int)blockParam(bpBodyWave);
+    r.sTra = blockParam(bpSubTrack) > 0.5f;
+    r.note = r.sTra ? lastMidiNote.load() : 0; // only a tracking sub depends on the note
+    r.sampleRate = (double)previewSampleRate.load();
+    r.startPhase = LayerOscillatorCore::phaseFromCycles(parameterValue(pMasterPhase) / 360.0);
+    r.subStartPhase = LayerOscillatorCore::phaseFromCycles((parameterValue(pSubPhase) + parameterValue(pMasterPhase)) / 360.0);
+    return r;
+}
 
-    float aPitVal = 0, aDecVal = 0, aCurVal = 0, aHPFVal = 0, aToneVal = 0, aLevVal = 0, aPanVal = 0, aPWVal = 0;
-    float pStaVal = 0, pEndVal = 0, pDecVal = 0, pGliVal = 0, pCurVal = 0, bRatVal = 0, bLevVal = 0, bDecVal = 0, bCurVal = 0, bPanVal = 0, bFiltVal = 0;
-    float sNotVal = 0, sDecV = 0, sCurV = 0, sLevV = 0, sPanV = 0, mDriVal = 0, mOutVal = 0, mRelVal = 0, lThrDB = 0, mLPFVal = 0;
-    double sBaseHz = 0, sFinalHz = 0;
+// Preview thread: each layer at its level, before pan and the master stage
+void NextGenKickAudioProcessor::renderPreview(const StemRequest& snapshot, PreviewFrame& frame) {
+    static constexpr VoiceParam layerLevels[numStemLayers] = { vpAtkLevel, vpBodyLevel, vpSubLevel };
+    std::vector<float> samples((size_t)StaticPreview::numSamples);
 
-    for (int i = 0; i < numSamples; ++i) {
-        // Check for Note On trigger at this exact sample
-        if (i == triggerSample) {
-            isNoteActive = true;
-            noteOnTime = 0.0;
-            subAttackCounter = 0;
+    for (int layer = 0; layer < numStemLayers; ++layer) {
+        StemRequest r = snapshot;
+        r.layer = layer;
+        r.maxLength = StaticPreview::numSamples;
 
-            filterAtkHP.reset(); filterAtkLP.reset(); filterBodyLP.reset();
+        CachedStem stem;
+        renderStem(r, stem);
 
-            double sPh = s_masterPhase.getTargetValue() / 360.0 * twoPi;
-            phaseAtk = phaseBody = sPh;
-            phaseSub = ((s_subPhase.getTargetValue() / 360.0) * twoPi) + sPh;
+        const float level = r.params[(size_t)layerLevels[layer]];
+        std::fill(samples.begin(), samples.end(), 0.0f);
+        for (int i = 0; i < stem.length(); ++i) samples[(size_t)i] = stem.samples[(size_t)i] * level;
+        frame.layers[(size_t)layer].build(samples.data(), StaticPreview::numSamples);
+    }
+}
 
-            fullWaveWriteIdx = 0;
-            isRecordingFullWave = true;
+void NextGenKickAudioProcessor::handleMidiEvent(const juce::MidiMessage& msg, const VoiceBlockContext& ctx) {
+    if (msg.isNoteOn()) {
+        lastMidiNote = msg.getNoteNumber();
+        noteOnCount.fetch_add(1, std::memory_order_relaxed);
+        startVoice(lastMidiNote, ctx);
+    }
+    else if (msg.isAllSoundOff()) {
+        voices.reset();
+        isNoteActive = false;
+    }
+}
 
-            {
-                std::lock_guard<std::mutex> lock(oversamplerMutex);
-                if (oversampler) oversampler->reset();
-            }
+// Renders [startSample, endSample) of the current chunk (at most internalChunkSize samples)
+void NextGenKickAudioProcessor::renderVoices(float* satL, float* satR, int startSample, int endSample, const VoiceBlockContext& ctx) {
+    const int spanLen = endSample - startSample;
+    jassert(spanLen > 0 && spanLen <= internalChunkSize);
+
+    if (voices.numActive == 0) {
+        for (auto& p : voiceParams) p.skip(spanLen);
+        std::fill(satL + startSample, satL + endSample, 0.0f);
+        std::fill(satR + startSample, satR + endSample, 0.0f);
+        if (layerBusesActive)
+            for (int c = 0; c < numLayerChannels; ++c) layerBuffer.clear(c, startSample, spanLen);
+    }
+    else {
+        // Only moving parameters fill a ramp; settled ones stay a scalar
+        for (auto& p : voiceParams) p.process(spanLen);
+        if (layerBusesActive)
+            for (int c = 0; c < numLayerChannels; ++c) layerSpan[(size_t)c] = layerBuffer.getWritePointer(c) + startSample;
+        (this->*renderKernel)(satL + startSample, satR + startSample, spanLen, ctx);
+    }
 
-            for (auto& s : satStates) s.reset();
-        }
+    // The post-voice chain reads the master values once per chunk
+    masterDriveVal = voiceParams[vpMasterDrive].getCurrentValue(); masterOutVal = voiceParams[vpMasterOut].getCurrentValue();
+    limThresholdDB = voiceParams[vpLimThreshold].getCurrentValue(); masterLPFVal = voiceParams[vpMasterLPF].getCurrentValue();
+}
+
+// AWav/BWav >= 0 bake the waveforms in, so the per-sample selection below folds away;
+// -1 reads them from ctx at run time (generic path)
+template <int AWav, int BWav>
+void NextGenKickAudioProcessor::renderSpan(float* satL, float* satR, int numSamples, const VoiceBlockContext& ctx) {
+    const auto& P = voiceParams;
+    const int aWav = AWav >= 0 ? AWav : ctx.aWav;
+    const int bWav = BWav >= 0 ? BWav : ctx.bWav;
 
-        if (!isNoteActive) {
+    const double invSR = 1.0 / (double)currentSampleRate;
+    const WavetableBank& tables = *wavetables;
+
+    // Derived values that only need per-sample work while their source is ramping
+    auto subFixedHz = [](float note) { return 440.0 * std::pow(2.0, ((double)note - 69.0) / 12.0); };
+    const double sFixedHzStatic = subFixedHz(P[vpSubNote][0]);
+
+    float* vAtk = voiceAtk.data();
+    float* vBody = voiceBody.data();
+    float* vSub = voiceSub.data();
+    auto& osc = voices.osc;
+    char* vDone = voiceDone.data();
+    const CachedStem* const* stemAtk = voices.stems[layerAtk].data();
+    const CachedStem* const* stemBody = voices.stems[layerBody].data();
+    const CachedStem* const* stemSub = voices.stems[layerSub].data();
+    const int* stemPos = voices.stemPos.data();
+
+    // Layer filter coefficients are control rate: once per span, from its first value
+    coefAtkHP.update(P[vpAtkHPF][0], currentSampleRate); coefAtkLP.update(P[vpAtkTone][0], currentSampleRate); coefBodyLP.update(P[vpBodyFilter][0], currentSampleRate);
+
+    // Noise attacks come from one block per span: numSamples x the voices alive at its start (voices
+    // only end inside a span). Skipped once every click is over or cached.
+    const int noiseStride = voices.numActive;
+    const float* noiseIn = noiseBlock.data();
+    if (aWav < 3) {
+        bool clicking = false;
+        for (int v = 0; v < noiseStride && !clicking; ++v)
+            clicking = stemAtk[v] == nullptr && !PowerDecayEnvelope::isFinished(voices.envAtk[v]);
+        if (clicking) noise.fill(aWav, noiseBlock.data(), numSamples * noiseStride);
+    }
+
+    // The layer buses take each layer's share of the mix from the same pass
+    const bool layersOut = layerBusesActive;
+
+    for (int i = 0; i < numSamples; ++i) {
+        const int nv = voices.numActive;
+        if (nv == 0) {
             satL[i] = 0.0f;
             satR[i] = 0.0f;
+            if (layersOut)
+                for (auto* p : layerSpan) p[i] = 0.0f;
             continue;
         }
 
-        aPitVal = s_atkPitch.getNextValue(); aDecVal = s_atkDecay.getNextValue(); aCurVal = s_atkCurve.getNextValue();
-        aHPFVal = s_atkHPF.getNextValue(); aToneVal = s_atkTone.getNextValue(); aLevVal = s_atkLevel.getNextValue();
-        aPanVal = s_atkPan.getNextValue(); aPWVal = s_atkPW.getNextValue();
-        pStaVal = s_pStart.getNextValue(); pEndVal = s_pEnd.getNextValue(); pDecVal = s_pDecay.getNextValue();
-        pGliVal = s_pGlide.getNextValue(); pCurVal = s_pCurve.getNextValue(); bRatVal = s_besselRatio.getNextValue();
-        bLevVal = s_bodyLevel.getNextValue(); bDecVal = s_bodyDecay.getNextValue(); bCurVal = s_bodyCurve.getNextValue();
-        bPanVal = s_bodyPan.getNextValue(); bFiltVal = s_bodyFilter.getNextValue();
-        sNotVal = sTra ? (float)lastMidiNote : s_subNote.getNextValue();
-
-        sBaseHz = 440.0 * std::pow(2.0, ((double)sNotVal - 69.0) / 12.0);
-        sFinalHz = sBaseHz + (double)s_subFine.getNextValue();
-
-        sDecV = s_subDecay.getNextValue(); sCurV = s_subCurve.getNextValue(); sLevV = s_subLevel.getNextValue();
-        sPanV = s_subPan.getNextValue();
-        mDriVal = s_masterDrive.getNextValue(); mOutVal = s_masterOut.getNextValue(); mRelVal = s_masterRelease.getNextValue();
-        lThrDB = s_limThreshold.getNextValue();
-        mLPFVal = s_masterLPF.getNextValue();
-
-        if (++crCounter >= 8) {
-            crCounter = 0;
-            filterAtkHP.setCutoffFrequency(aHPFVal); filterAtkLP.setCutoffFrequency(aToneVal); filterBodyLP.setCutoffFrequency(bFiltVal);
-            for (auto& f : filterMasterLP_L) f.setCutoffFrequency(mLPFVal);
-            for (auto& f : filterMasterLP_R) f.setCutoffFrequency(mLPFVal);
+        const float aPitVal = P[vpAtkPitch][i], aDecVal = P[vpAtkDecay][i], aCurVal = P[vpAtkCurve][i];
+        const float aLevVal = P[vpAtkLevel][i], aPanVal = P[vpAtkPan][i], aPWVal = P[vpAtkPW][i];
+        const float pStaVal = P[vpPStart][i], pEndVal = P[vpPEnd][i], pDecVal = P[vpPDecay][i];
+        const float pGliVal = P[vpPGlide][i], pCurVal = P[vpPCurve][i], bRatVal = P[vpBesselRatio][i];
+        const float bLevVal = P[vpBodyLevel][i], bDecVal = P[vpBodyDecay][i], bCurVal = P[vpBodyCurve][i];
+        const float bPanVal = P[vpBodyPan][i];
+        const float sFineVal = P[vpSubFine][i], sDecV = P[vpSubDecay][i], sCurV = P[vpSubCurve][i];
+        const float sLevV = P[vpSubLevel][i], sPanV = P[vpSubPan][i], mRelVal = P[vpMasterRelease][i];
+
+        const double sFixedHz = P[vpSubNote].isRamping() ? subFixedHz(P[vpSubNote][i]) : sFixedHzStatic;
+
+        // Envelope coefficients are shared; each call is a no-op unless its parameters moved
+        atkEnv.setParameters(aDecVal, aCurVal, currentSampleRate);
+        pitchEnv.setParameters(pDecVal, pCurVal, currentSampleRate);
+        bodyEnv.setParameters(bDecVal, bCurVal, currentSampleRate);
+        subEnv.setParameters(sDecV, sCurV, currentSampleRate);
+        subFade.setParameters(P[vpSubAntiClick][i], currentSampleRate);
+
+        const double dtA = (double)aPitVal * invSR;
+        const juce::uint32 incA = LayerOscillatorCore::increment(dtA);
+
+        // --- Attack (per voice): a sine plays in its oscillator lane, other shapes and noise here ---
+        for (int v = 0; v < nv; ++v) {
+            const int lane = LayerOscillatorCore::index(v, LayerOscillatorCore::laneAtk);
+            osc.inc[(size_t)lane] = incA;
+            osc.gain[(size_t)lane] = 0.0f;
+            if (const auto* stem = stemAtk[v]) { vAtk[v] = stem->sampleAt(stemPos[v]) * aLevVal; continue; }
+
+            const float atkEnvVal = atkEnv.tick(voices.envAtk[v], voices.time[v]);
+            if (PowerDecayEnvelope::isFinished(voices.envAtk[v])) { vAtk[v] = 0.0f; continue; } // click is over, skip the oscillator
+
+            if (aWav == atkSineWave) { vAtk[v] = 0.0f; osc.gain[(size_t)lane] = atkEnvVal * aLevVal; continue; }
+
+            const double atkRaw = aWav < 3 ? (double)noiseIn[i * noiseStride + v] : atkOscillator(tables, aWav, osc.phase[(size_t)lane], dtA, aPWVal);
+            vAtk[v] = (float)atkRaw * atkEnvVal * aLevVal;
         }
 
-        double atkRaw = 0.0; double dtA = (double)aPitVal * invSR;
-        if (aWav == 0) {
-            if (hasSpareNoise) { atkRaw = spareNoise; hasSpareNoise = false; }
+        // --- Body & Sub oscillators and envelopes (per voice) ---
+        // A cached layer reads its stem; its phase stays put (increment 0) until a hand-over sets it
+        for (int v = 0; v < nv; ++v) {
+            const float tm = (float)voices.time[v];
+            const int bodyLane = LayerOscillatorCore::index(v, LayerOscillatorCore::laneBody);
+            const int subLane = LayerOscillatorCore::index(v, LayerOscillatorCore::laneSub);
+            float bodyEnvVal, subEnvBase;
+
+            if (const auto* stem = stemBody[v]) {
+                vBody[v] = stem->sampleAt(stemPos[v]) * bLevVal;
+                bodyEnvVal = stem->envelopeAt(stemPos[v]);
+                osc.inc[(size_t)bodyLane] = 0;
+                osc.gain[(size_t)bodyLane] = 0.0f;
+            }
             else {
-                float u1 = random.nextFloat(), u2 = random.nextFloat();
-                float mag = std::sqrt(-2.0f * std::log(u1 + 1e-9f));
-                atkRaw = mag * std::cos(twoPi * u2) * 0.4f; spareNoise = mag * std::sin(twoPi * u2) * 0.4f; hasSpareNoise = true;
+                float pE = pitchEnv.tick(voices.envPitch[v]);
+                double fBody = (double)pEndVal + ((double)pStaVal - (double)pEndVal) * (pE + pGliVal * (pE * pE * pE));
+                double dtB = fBody * invSR;
+
+                bodyEnvVal = bodyEnv.tick(voices.envBody[v]);
+                osc.inc[(size_t)bodyLane] = LayerOscillatorCore::increment(dtB);
+                if (bWav == bodySineWave) {
+                    vBody[v] = 0.0f;
+                    osc.gain[(size_t)bodyLane] = bodyEnvVal * bLevVal;
+                }
+                else {
+                    double bodyRaw = bodyOscillator(tables, bWav, osc.phase[(size_t)bodyLane], dtB, bRatVal);
+                    vBody[v] = (float)bodyRaw * bodyEnvVal * bLevVal;
+                    osc.gain[(size_t)bodyLane] = 0.0f;
+                }
             }
-        }
-        else if (aWav == 1) atkRaw = getPinkNoise();
-        else if (aWav == 2) { float w = random.nextFloat() * 2.0f - 1.0f; lastBrown = (lastBrown + 0.02f * w) / 1.02f; atkRaw = lastBrown * 3.5f; }
-        else if (aWav == 3) { double t = phaseAtk * invTwoPi; atkRaw = (t < 0.5 ? 1.0 : -1.0) + polyBlep(t, dtA) - polyBlep(std::fmod(t + 0.5, 1.0), dtA); }
-        else if (aWav == 4) { double t = phaseAtk * invTwoPi; atkRaw = (2.0 * t - 1.0) - polyBlep(t, dtA); }
-        else if (aWav == 5) { double t = phaseAtk * invTwoPi; atkRaw = std::abs(t - 0.5) * 4.0 - 1.0; }
-        else if (aWav == 6) { double t = phaseAtk * invTwoPi; atkRaw = (t < aPWVal ? 1.0 : -1.0) + polyBlep(t, dtA) - polyBlep(std::fmod(t + (1.0 - aPWVal), 1.0), dtA); }
-        else atkRaw = generateUltraPureSine(phaseAtk);
-
-        float atkEnv = std::pow(std::max(0.0f, 1.0f - (float)noteOnTime / (aDecVal + 0.0001f)), aCurVal);
-        float atkCalc = (float)atkRaw * atkEnv * aLevVal;
-
-        float atkFilt = filterAtkHP.processSample(0, atkCalc);
-        atkFilt = filterAtkLP.processSample(0, atkFilt);
 
-        float pE = std::pow(std::exp(-(float)noteOnTime / (pDecVal + 0.0001f)), pCurVal);
-        double fBody = (double)pEndVal + ((double)pStaVal - (double)pEndVal) * (pE + pGliVal * (pE * pE * pE));
-        double dtB = fBody * invSR; double bodyRaw = 0.0;
+            if (const auto* stem = stemSub[v]) {
+                vSub[v] = stem->sampleAt(stemPos[v]) * sLevV;
+                subEnvBase = stem->envelopeAt(stemPos[v]);
+                osc.inc[(size_t)subLane] = 0;
+                osc.gain[(size_t)subLane] = 0.0f;
+            }
+            else {
+                subEnvBase = subEnv.tick(voices.envSub[v]);
+                float antiC = subFade.tick(voices.subFade[v]);
+                vSub[v] = 0.0f;
+                osc.gain[(size_t)subLane] = subEnvBase * antiC * sLevV;
+                osc.inc[(size_t)subLane] = LayerOscillatorCore::increment(((ctx.sTra ? (double)voices.subBaseHz[v] : sFixedHz) + (double)sFineVal) * invSR);
+            }
 
-        if (bWav == 0) bodyRaw = generateUltraPureSine(phaseBody);
-        else if (bWav == 1) bodyRaw = (generateUltraPureSine(phaseBody) + 0.4 * generateUltraPureSine(phaseBody * bRatVal) + 0.2 * generateUltraPureSine(phaseBody * 2.135)) / 1.7;
-        else if (bWav == 2) { double t = phaseBody * invTwoPi; bodyRaw = (2.0 * t - 1.0) - polyBlep(t, dtB); }
-        else if (bWav == 3) { double t = phaseBody * invTwoPi; bodyRaw = (t < 0.5 ? 1.0 : -1.0) + polyBlep(t, dtB) - polyBlep(std::fmod(t + 0.5, 1.0), dtB); }
-        else { double t = phaseBody * invTwoPi; bodyRaw = std::abs(t - 0.5) * 4.0 - 1.0; }
+            voices.level[v] = std::max(bodyEnvVal, subEnvBase);
+            vDone[v] = (subEnvBase < 0.0001f && bodyEnvVal < 0.0001f && (double)tm + invSR > (double)mRelVal) ? 1 : 0;
+        }
 
-        float bodyEnv = std::pow(std::exp(-(float)noteOnTime / (bDecVal + 0.0001f)), bCurVal);
-        float bodySig = (float)bodyRaw * bodyEnv * bLevVal;
+        // --- Sine lanes of every voice in one pass; advances all phases ---
+        osc.process(nv * LayerOscillatorCore::lanesPerVoice);
+        for (int v = 0; v < nv; ++v) {
+            vAtk[v] += osc.out[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneAtk)];
+            vBody[v] += osc.out[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneBody)];
+            vSub[v] += osc.out[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneSub)];
+        }
 
-        float bodyFilt = filterBodyLP.processSample(0, bodySig);
+        // --- Layer filters: shared coefficients, per-voice state (stems come pre-filtered) ---
+        for (int v = 0; v < nv; ++v) {
+            if (stemAtk[v] == nullptr) {
+                const float hp = coefAtkHP.processHighpass(vAtk[v], voices.atkHP1[v], voices.atkHP2[v]);
+                vAtk[v] = coefAtkLP.processLowpass(hp, voices.atkLP1[v], voices.atkLP2[v]);
+            }
+            if (stemBody[v] == nullptr) vBody[v] = coefBodyLP.processLowpass(vBody[v], voices.bodyLP1[v], voices.bodyLP2[v]);
+        }
 
-        float subEnvBase = std::pow(std::exp(-(float)noteOnTime / (sDecV + 0.0001f)), sCurV);
-        float sAnt = s_subAntiClick.getNextValue();
-        float subFadeInv = 1.0f / ((sAnt / 1000.0f) * (float)currentSampleRate + 0.001f);
-        float antiC = (subAttackCounter * subFadeInv < 1.0f) ? 0.5f * (1.0f - std::cos(juce::MathConstants<float>::pi * (float)subAttackCounter++ * subFadeInv)) : 1.0f;
-        float subFinal = (float)generateUltraPureSine(phaseSub) * subEnvBase * antiC * sLevV;
+        float atkFilt = 0.0f, bodyFilt = 0.0f, subFinal = 0.0f;
+        for (int v = 0; v < nv; ++v) {
+            const float g = voices.stealGain[v];
+            atkFilt += vAtk[v] * g;
+            bodyFilt += vBody[v] * g;
+            subFinal += vSub[v] * g;
+        }
 
         float mixL = (atkFilt * (1.0f - aPanVal)) + (bodyFilt * (1.0f - bPanVal)) + (subFinal * (1.0f - sPanV));
         float mixR = (atkFilt * (1.0f + aPanVal)) + (bodyFilt * (1.0f + bPanVal)) + (subFinal * (1.0f + sPanV));
@@ -697,71 +1085,196 @@ void NextGenKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
         satR[i] = (mixR + lastMixR) * 0.5f;
         lastMixL = mixL; lastMixR = mixR;
 
-        if (isRecordingFullWave) {
-            int fIdx = fullWaveWriteIdx.load();
-            if (fIdx < fullWaveSize) {
-                fullWaveAtk[fIdx] = atkFilt;
-                fullWaveBody[fIdx] = bodyFilt;
-                fullWaveSub[fIdx] = subFinal;
-                fullWaveWriteIdx.store(fIdx + 1);
+        if (layersOut) {
+            const float layerMix[numLayerChannels] = {
+                atkFilt * (1.0f - aPanVal) * 0.6f, atkFilt * (1.0f + aPanVal) * 0.6f,
+                bodyFilt * (1.0f - bPanVal) * 0.6f, bodyFilt * (1.0f + bPanVal) * 0.6f,
+                subFinal * (1.0f - sPanV) * 0.6f, subFinal * (1.0f + sPanV) * 0.6f
+            };
+            for (int c = 0; c < numLayerChannels; ++c) {
+                layerSpan[(size_t)c][i] = (layerMix[c] + lastLayerMix[(size_t)c]) * 0.5f;
+                lastLayerMix[(size_t)c] = layerMix[c];
             }
-            else { isRecordingFullWave = false; }
         }
 
-        phaseBody += twoPi * dtB; if (phaseBody >= twoPi) phaseBody -= twoPi;
-        phaseSub += twoPi * (sFinalHz * invSR); if (phaseSub >= twoPi) phaseSub -= twoPi;
-        phaseAtk += twoPi * dtA; if (phaseAtk >= twoPi) phaseAtk -= twoPi;
-        noteOnTime += (double)invSR;
+        // --- Advance time (per voice; the phases moved in the oscillator pass) ---
+        for (int v = 0; v < nv; ++v) {
+            voices.time[v] += invSR;
+            if (voices.hasStems(v)) advanceStems(v, aLevVal, bLevVal);
+            if (voices.isFadingOut(v) && (voices.stealGain[v] -= voices.stealStep[v]) <= 0.0f) vDone[v] = 1;
+        }
+
+        // Retire finished voices (backwards, so the packing swap never skips one)
+        for (int v = nv - 1; v >= 0; --v)
+            if (vDone[v]) voices.remove(v);
+
+        if (voices.numActive == 0) isNoteActive = false;
+    }
+}
+
+void NextGenKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto numSamples = buffer.getNumSamples();
 
-        if (subEnvBase < 0.0001f && bodyEnv < 0.0001f && noteOnTime >(double)mRelVal) { isNoteActive = false; }
+    const double invSR = 1.0 / (double)currentSampleRate;
+
+    const int sMod = (int)blockParam(bpSatType);
+
+    VoiceBlockContext ctx;
+    ctx.aWav = (int)blockParam(bpAtkWave);
+    ctx.bWav = (int)blockParam(bpBodyWave);
+    ctx.sTra = blockParam(bpSubTrack) > 0.5f;
+    ctx.polyphony = KickVoicePool::polyphonyFromChoice((int)blockParam(bpPolyphony));
+    ctx.stealMode = (VoiceStealMode)(int)blockParam(bpVoiceSteal);
+    const int newOsMode = juce::jlimit(0, numOsModes - 1, (int)blockParam(bpOsMode));
+
+    selectKernels(ctx.aWav, ctx.bWav, sMod);
+
+    if (newOsMode != currentOsMode) switchOversampler(newOsMode);
+
+    const float dcAlpha = std::exp(-(float)invSR * (1.0f / 0.075f));
+
+    const int lookaheadSamples = getLookaheadSamples();
+    limTruePeak = blockParam(bpLimTruePeak) > 0.5f;
+    const bool idleBypass = useIdleBypass.load(std::memory_order_relaxed);
+    const bool layersPostMaster = (int)blockParam(bpLayerOutMode) == layerOutPostMaster;
+
+    // Publish latency (OS + Limiter); timerCallback reports it. The layer buses are delayed by the
+    // same amount for the whole block, from the values the main path latched above.
+    layerDelay = computeLatency(lookaheadSamples, limTruePeak);
+    pendingLatency.store(layerDelay, std::memory_order_relaxed);
+
+    auto* satL = satBuffer.getWritePointer(0);
+    auto* satR = satBuffer.getWritePointer(1);
+    // Main output; a mono bus gets (L + R) / 2, the right channel going through monoFoldBuffer
+    auto mainOut = getBusBuffer(buffer, false, 0);
+    const bool monoOut = mainOut.getNumChannels() < 2;
+    auto* outL = mainOut.getWritePointer(0);
+    auto* outR = monoOut ? nullptr : mainOut.getWritePointer(1);
+
+    // Layer buses the host enabled (a disabled bus has no channels)
+    std::array<float*, numLayerChannels> layerBlockOut{};
+    layerBusesActive = false;
+    for (int l = 0; l < numLayerBuses && 1 + l < getBusCount(false); ++l) {
+        auto bus = getBusBuffer(buffer, false, 1 + l);
+        if (bus.getNumChannels() < 2) continue;
+        layerBlockOut[(size_t)(2 * l)] = bus.getWritePointer(0);
+        layerBlockOut[(size_t)(2 * l + 1)] = bus.getWritePointer(1);
+        layerBusesActive = true;
     }
 
-    juce::dsp::AudioBlock<float> satBlock(satBuffer);
+    auto midiIt = midiMessages.begin();
+    const auto midiEnd = midiMessages.end();
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += internalChunkSize) {
+        const int chunkLen = std::min(internalChunkSize, numSamples - chunkStart);
+        updateParameters();
+
+        // --- Event Scheduler: render up to each MIDI event in this chunk, apply it, continue ---
+        int cursor = 0;
+        for (; midiIt != midiEnd; ++midiIt) {
+            const auto metadata = *midiIt;
+            const int pos = juce::jlimit(0, numSamples, metadata.samplePosition) - chunkStart;
+            if (pos >= chunkLen) break;
+            if (pos > cursor) { renderVoices(satL, satR, cursor, pos, ctx); cursor = pos; }
+            handleMidiEvent(metadata.getMessage(), ctx);
+        }
+        if (cursor < chunkLen) renderVoices(satL, satR, cursor, chunkLen, ctx);
+
+        if (layerBusesActive)
+            for (int c = 0; c < numLayerChannels; ++c)
+                layerOut[(size_t)c] = layerBlockOut[(size_t)c] != nullptr ? layerBlockOut[(size_t)c] + chunkStart : nullptr;
 
-    // Locked Oversampling Process
-    {
-        std::lock_guard<std::mutex> lock(oversamplerMutex);
-        if (oversampler) {
-            auto upsampledBlock = oversampler->processSamplesUp(satBlock);
-            for (int ch = 0; ch < 2; ++ch) {
-                auto* p = upsampledBlock.getChannelPointer(ch);
-                auto& state = satStates[ch];
-                for (int i = 0; i < (int)upsampledBlock.getNumSamples(); ++i) {
-                    p[i] = processSaturationSampleADAA(p[i], sMod, mDriVal, state);
-                }
-            }
-            oversampler->processSamplesDown(satBlock);
+        float* chunkL = outL + chunkStart;
+        float* chunkR = monoOut ? monoFoldBuffer.data() : outR + chunkStart;
+        if (chainIdle && idleBypass && voices.numActive == 0) {
+            renderIdleChunk(chunkL, chunkR, chunkLen);
         }
         else {
-            for (int ch = 0; ch < 2; ++ch) {
-                auto* p = satBlock.getChannelPointer(ch);
-                auto& state = satStates[ch];
-                for (int i = 0; i < numSamples; ++i) {
-                    p[i] = processSaturationSampleADAA(p[i], sMod, mDriVal, state);
-                }
+            chainIdle = false;
+            renderChunkOutput(chunkL, chunkR, chunkLen, sMod, lookaheadSamples, dcAlpha, layersPostMaster);
+        }
+
+        if (monoOut)
+            for (int i = 0; i < chunkLen; ++i) chunkL[i] = (chunkL[i] + chunkR[i]) * 0.5f;
+    }
+
+    // Events at the very end of the block start sounding in the next one
+    for (; midiIt != midiEnd; ++midiIt) handleMidiEvent((*midiIt).getMessage(), ctx);
+}
+
+// Saturation and output stage for one chunk; satBuffer holds its voice mix
+void NextGenKickAudioProcessor::renderChunkOutput(float* outL, float* outR, int numSamples, int satType, int lookaheadSamples, float dcAlpha, bool layersPostMaster) {
+    // --- Oversampled saturation (crossfading from the previous mode after a switch) ---
+    auto satBlock = juce::dsp::AudioBlock<float>(satBuffer).getSubBlock(0, (size_t)numSamples);
+
+    if (fadeOsMode >= 0) {
+        auto fadeBlock = juce::dsp::AudioBlock<float>(osFadeBuffer).getSubBlock(0, (size_t)numSamples);
+        fadeBlock.copyFrom(satBlock);
+        saturateOversampled(fadeOsMode, fadeBlock, fadeSatStates, satType);
+        saturateOversampled(currentOsMode, satBlock, satStates, satType);
+
+        const float fadeStep = 1.0f / (float)osFadeLength;
+        for (int ch = 0; ch < 2; ++ch) {
+            auto* dst = satBlock.getChannelPointer((size_t)ch);
+            const auto* old = fadeBlock.getChannelPointer((size_t)ch);
+            for (int i = 0; i < numSamples; ++i) {
+                const float g = juce::jmin(1.0f, (float)(osFadePos + i) * fadeStep);
+                dst[i] = old[i] + (dst[i] - old[i]) * g;
             }
         }
+        osFadePos += numSamples;
+        if (osFadePos >= osFadeLength) fadeOsMode = -1;
+    }
+    else {
+        saturateOversampled(currentOsMode, satBlock, satStates, satType);
     }
 
-    auto* outL = buffer.getWritePointer(0); auto* outR = buffer.getWritePointer(1);
-    const float* srcL = satBuffer.getReadPointer(0);
-    const float* srcR = satBuffer.getReadPointer(1);
+    float* srcL = satBuffer.getWritePointer(0);
+    float* srcR = satBuffer.getWritePointer(1);
 
-    int visStart1 = 0, visSize1 = 0, visStart2 = 0, visSize2 = 0;
-    std::vector<float> tempVisBuffer(numSamples);
-    visualFifo.prepareToWrite(numSamples, visStart1, visSize1, visStart2, visSize2);
+    // --- Control rate: master LPF cutoff (ramped over the chunk) and limiter threshold ---
+    const bool masterLPFOn = masterLPFVal < masterLPFOffHz;
+    if (masterLPFOn) masterLowpass.setCutoff(masterLPFVal);
 
-    float driveComp = 1.0f / std::sqrt(std::max(1.0f, mDriVal));
+    const float driveComp = 1.0f / std::sqrt(std::max(1.0f, masterDriveVal));
+    const float lThr = juce::Decibels::decibelsToGain(limThresholdDB);
+    const int audioDelay = limTruePeak ? TruePeakInterpolator::delay : 0;
 
     for (int i = 0; i < numSamples; ++i) {
-        float driveL = srcL[i] * driveComp * mOutVal;
-        float driveR = srcR[i] * driveComp * mOutVal;
+        srcL[i] = srcL[i] * driveComp * masterOutVal;
+        srcR[i] = srcR[i] * driveComp * masterOutVal;
+    }
+
+    // Apply Master LPF (Stereo, 4-stage cascade = 48dB/oct), both channels and all stages in SIMD lanes
+    if (masterLPFOn) masterLowpass.process(srcL, srcR, numSamples);
 
-        // Apply Master LPF (Stereo, 4-stage cascade = 48dB/oct)
-        if (mLPFVal < 19950.0f) {
-            for (auto& f : filterMasterLP_L) driveL = f.processSample(0, driveL);
-            for (auto& f : filterMasterLP_R) driveR = f.processSample(0, driveR);
+    // --- Layer buses: Post Master runs them through the same gain and hi-cut ---
+    const bool layersOut = layerBusesActive;
+    const bool layersPost = layersOut && layersPostMaster;
+    std::array<float*, numLayerChannels> layerIn{};
+    if (layersOut) {
+        for (int c = 0; c < numLayerChannels; ++c) layerIn[(size_t)c] = layerBuffer.getWritePointer(c);
+    }
+    if (layersPost) {
+        // The saturation stage as a plain gain: drive x driveComp, the curves' slope at 0 taken as 1
+        const float layerGain = masterDriveVal * driveComp * masterOutVal;
+        for (int l = 0; l < numLayerBuses; ++l) {
+            float* inL = layerIn[(size_t)(2 * l)];
+            float* inR = layerIn[(size_t)(2 * l + 1)];
+            for (int i = 0; i < numSamples; ++i) { inL[i] *= layerGain; inR[i] *= layerGain; }
+            if (masterLPFOn) {
+                layerLowpass[(size_t)l].setCutoff(masterLPFVal);
+                layerLowpass[(size_t)l].process(inL, inR, numSamples);
+            }
         }
+    }
+
+    float inputPeak = 0.0f, outputPeak = 0.0f;
+    for (int i = 0; i < numSamples; ++i) {
+        float driveL = srcL[i];
+        float driveR = srcR[i];
 
         float mWidthVal = s_masterWidth.getNextValue();
         float mid = (driveL + driveR) * 0.5f;
@@ -771,48 +1284,268 @@ void NextGenKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 
         limBufferL[limWriteIdx] = driveL;
         limBufferR[limWriteIdx] = driveR;
-
-        float currentInputAbs = std::max(std::abs(driveL), std::abs(driveR));
-        int windowTailIdx = (limWriteIdx - lookaheadSamples + limBufferSize) & limMask;
-
-        if (currentInputAbs >= cachedPeak) {
-            cachedPeak = currentInputAbs;
-            cachedPeakIdx = limWriteIdx;
+        inputPeak = std::max(inputPeak, std::max(std::abs(driveL), std::abs(driveR)));
+
+        // Window covers the outgoing sample and everything after it: lookahead + 1 detector values
+        float detected;
+        if (limTruePeak) {
+            const int w = limWriteIdx;
+            const float tpL = truePeakDetector.process([this, w](int k) { return limBufferL[(size_t)((w - k) & limMask)]; });
+            const float tpR = truePeakDetector.process([this, w](int k) { return limBufferR[(size_t)((w - k) & limMask)]; });
+            detected = std::max(tpL, tpR);
         }
-        else if (cachedPeakIdx == windowTailIdx) {
-            cachedPeak = 0.0f;
-            for (int k = 0; k < lookaheadSamples; ++k) {
-                int idx = (limWriteIdx - k + limBufferSize) & limMask;
-                float p = std::max({ cachedPeak, std::abs(limBufferL[idx]), std::abs(limBufferR[idx]) });
-                if (p > cachedPeak) {
-                    cachedPeak = p;
-                    cachedPeakIdx = idx;
-                }
-            }
+        else {
+            detected = std::max(std::abs(driveL), std::abs(driveR));
         }
+        const float peak = limPeakWindow.push(detected, lookaheadSamples + 1);
+        int windowTailIdx = (limWriteIdx - lookaheadSamples - audioDelay + limBufferSize) & limMask;
 
-        float lThr = juce::Decibels::decibelsToGain(lThrDB);
-        float gain = (cachedPeak > lThr) ? (lThr / cachedPeak) : 1.0f;
+        float gain = (peak > lThr) ? (lThr / peak) : 1.0f;
 
         float outRawL = limBufferL[windowTailIdx] * gain;
         float outRawR = limBufferR[windowTailIdx] * gain;
+
+        // Layers: delayed to the main output; Post Master adds width, the main limiter's gain and a DC blocker
+        if (layersOut) {
+            const int layerTailIdx = (limWriteIdx - layerDelay + limBufferSize) & limMask;
+            for (int c = 0; c < numLayerChannels; c += 2) {
+                float inL = layerIn[(size_t)c][i], inR = layerIn[(size_t)c + 1][i];
+                if (layersPost) {
+                    const float layerMid = (inL + inR) * 0.5f, layerSide = (inL - inR) * 0.5f * mWidthVal;
+                    inL = layerMid + layerSide;
+                    inR = layerMid - layerSide;
+                }
+                auto& ringL = layerRing[(size_t)c];
+                auto& ringR = layerRing[(size_t)c + 1];
+                ringL[(size_t)limWriteIdx] = inL;
+                ringR[(size_t)limWriteIdx] = inR;
+                inputPeak = std::max(inputPeak, std::max(std::abs(inL), std::abs(inR)));
+
+                float layerL = ringL[(size_t)layerTailIdx], layerR = ringR[(size_t)layerTailIdx];
+                if (layersPost) {
+                    layerL *= gain;
+                    layerR *= gain;
+                    layerDcOut[(size_t)c] = layerL - layerDcIn[(size_t)c] + dcAlpha * layerDcOut[(size_t)c]; layerDcIn[(size_t)c] = layerL;
+                    layerDcOut[(size_t)c + 1] = layerR - layerDcIn[(size_t)c + 1] + dcAlpha * layerDcOut[(size_t)c + 1]; layerDcIn[(size_t)c + 1] = layerR;
+                    layerL = layerDcOut[(size_t)c];
+                    layerR = layerDcOut[(size_t)c + 1];
+                }
+                if (layerOut[(size_t)c] != nullptr) {
+                    layerOut[(size_t)c][i] = layerL;
+                    layerOut[(size_t)c + 1][i] = layerR;
+                }
+                outputPeak = std::max(outputPeak, std::max(std::abs(layerL), std::abs(layerR)));
+            }
+        }
         limWriteIdx = (limWriteIdx + 1) & limMask;
 
         dcLastOutL = outRawL - dcLastInL + dcAlpha * dcLastOutL; dcLastInL = outRawL;
         dcLastOutR = outRawR - dcLastInR + dcAlpha * dcLastOutR; dcLastInR = outRawR;
         outL[i] = dcLastOutL; outR[i] = dcLastOutR;
+        outputPeak = std::max(outputPeak, std::max(std::abs(dcLastOutL), std::abs(dcLastOutR)));
+    }
+
+    meterStream.push(outL, outR, numSamples);
+
+    // --- Silence tracking: once the chain has drained, flush it and go idle ---
+    quietSamples = inputPeak <= silenceThreshold ? std::min(quietSamples + numSamples, limBufferSize) : 0;
+    if (voices.numActive == 0 && fadeOsMode < 0 && quietSamples == limBufferSize && outputPeak <= silenceThreshold
+        && useIdleBypass.load(std::memory_order_relaxed)) {
+        flushChain();
+        chainIdle = true;
+    }
+}
+
+// The chain has drained below silenceThreshold: zero every state it still holds
+void NextGenKickAudioProcessor::flushChain() noexcept {
+    for (auto& os : oversamplers)
+        if (os != nullptr) os->reset();
+    for (auto& s : satStates) s.reset();
+    for (auto& s : fadeSatStates) s.reset();
+    masterLowpass.reset();
+    std::fill(limBufferL.begin(), limBufferL.end(), 0.0f);
+    std::fill(limBufferR.begin(), limBufferR.end(), 0.0f);
+    limPeakWindow.reset();
+    lastMixL = lastMixR = 0.0f;
+    dcLastInL = dcLastOutL = dcLastInR = dcLastOutR = 0.0f;
+    for (auto& ring : layerRing) std::fill(ring.begin(), ring.end(), 0.0f);
+    for (auto& lp : layerLowpass) lp.reset();
+    lastLayerMix.fill(0.0f);
+    layerDcIn.fill(0.0f);
+    layerDcOut.fill(0.0f);
+}
+
+// Idle chain: every state is zero and stays zero. Only what moves whatever the signal advances:
+// the width smoother, the ring position, the LPF coefficient ramp, an OS crossfade and the meter.
+void NextGenKickAudioProcessor::renderIdleChunk(float* outL, float* outR, int numSamples) noexcept {
+    std::fill(outL, outL + numSamples, 0.0f);
+    std::fill(outR, outR + numSamples, 0.0f);
+    if (layerBusesActive)
+        for (auto* p : layerOut)
+            if (p != nullptr) std::fill(p, p + numSamples, 0.0f);
+
+    s_masterWidth.skip(numSamples);
+    limWriteIdx = (limWriteIdx + numSamples) & limMask;
+    if (masterLPFVal < masterLPFOffHz) {
+        masterLowpass.setCutoff(masterLPFVal);
+        masterLowpass.skip();
+        for (auto& lp : layerLowpass) { lp.setCutoff(masterLPFVal); lp.skip(); }
+    }
+    if (fadeOsMode >= 0 && (osFadePos += numSamples) >= osFadeLength) fadeOsMode = -1;
+    meterStream.pushSilence(numSamples);
+}
 
-        tempVisBuffer[i] = (dcLastOutL + dcLastOutR) * 0.5f;
+#if NGK_HEADLESS
+// --- Isolated kernels for the benchmark suite ---
+// Oscillators sweep 1000 -> 30 Hz every 0.1 s (the body range), so wraps and polyBLEP corrections
+// are part of the timing; filters and detectors see the input the suite feeds them.
+std::vector<NextGenKickAudioProcessor::KernelBenchmark> NextGenKickAudioProcessor::makeKernelBenchmarks(double sampleRate) {
+    std::vector<KernelBenchmark> kernels;
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    const int sweepLength = juce::jmax(1, (int)(0.1 * sampleRate));
+    auto sweepHz = [sweepLength](int pos) { return 30.0 + 970.0 * (1.0 - (double)(pos % sweepLength) / (double)sweepLength); };
+
+    static const char* atkNames[] = { "White", "Pink", "Brown", "Square", "Saw", "Triangle", "Pulse", "Ultra Sine" };
+    for (int aWav = 3; aWav < numAtkWaves; ++aWav)
+        kernels.push_back({ juce::String("atkOscillator/") + atkNames[aWav], [=, phase = juce::uint32(0), pos = 0](const float*, float* out, int n) mutable {
+            for (int i = 0; i < n; ++i, ++pos) {
+                const double dt = sweepHz(pos) / sampleRate;
+                phase += LayerOscillatorCore::increment(dt);
+                out[i] = (float)atkOscillator(*wavetables, aWav, phase, dt, 0.3f);
+            }
+        } });
+
+    // Noise attacks: the block generator, filled a call at a time as renderSpan does per span
+    for (int aWav = 0; aWav < 3; ++aWav)
+        kernels.push_back({ juce::String("noise/") + atkNames[aWav], [aWav, noise = NoiseGenerator(1)](const float*, float* out, int n) mutable {
+            noise.fill(aWav, out, n);
+        } });
+
+    static const char* bodyNames[] = { "Ultra Sine", "Bessel", "Saw", "Square", "Triangle" };
+    for (int bWav = 0; bWav < numBodyWaves; ++bWav)
+        kernels.push_back({ juce::String("bodyOscillator/") + bodyNames[bWav], [=, phase = juce::uint32(0), pos = 0](const float*, float* out, int n) mutable {
+            for (int i = 0; i < n; ++i, ++pos) {
+                const double dt = sweepHz(pos) / sampleRate;
+                phase += LayerOscillatorCore::increment(dt);
+                out[i] = (float)bodyOscillator(*wavetables, bWav, phase, dt, 1.6f);
+            }
+        } });
+
+    // Oscillator core: the sine lanes of 1, 4 and 16 voices (attack, body, sub each) per output sample,
+    // against the double phases with compare-and-subtract wrap and double polynomial it replaced
+    for (int numVoices : { 1, 4, 16 }) {
+        auto core = std::make_shared<LayerOscillatorCore>();
+        kernels.push_back({ "oscillatorCore/" + juce::String(numVoices) + " voices (" + LayerOscillatorCore::instructionSet() + ")",
+            [=, pos = 0](const float*, float* out, int n) mutable {
+            for (int i = 0; i < n; ++i, ++pos) {
+                const double dt = sweepHz(pos) / sampleRate;
+                for (int v = 0; v < numVoices; ++v) {
+                    core->inc[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneAtk)] = LayerOscillatorCore::increment(dt * 8.0);
+                    core->inc[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneBody)] = LayerOscillatorCore::increment(dt);
+                    core->inc[(size_t)LayerOscillatorCore::index(v, LayerOscillatorCore::laneSub)] = LayerOscillatorCore::increment(50.0 / sampleRate);
+                    for (int lane = 0; lane < 3; ++lane) core->gain[(size_t)LayerOscillatorCore::index(v, lane)] = 0.3f;
+                }
+                core->process(numVoices * LayerOscillatorCore::lanesPerVoice);
+                float sum = 0.0f;
+                for (int k = 0; k < numVoices * LayerOscillatorCore::lanesPerVoice; ++k) sum += core->out[(size_t)k];
+                out[i] = sum;
+            }
+        } });
+
+        kernels.push_back({ "oscillatorCore/" + juce::String(numVoices) + " voices (double phases, before)",
+            [=, phases = std::array<double, 3 * KickVoicePool::maxVoices>{}, pos = 0](const float*, float* out, int n) mutable {
+            auto ultraPureSine = [](double phase) {
+                double x = phase - juce::MathConstants<double>::pi;
+                if (x < -juce::MathConstants<double>::pi) x += juce::MathConstants<double>::twoPi;
+                else if (x > juce::MathConstants<double>::pi) x -= juce::MathConstants<double>::twoPi;
+                const double x2 = x * x;
+                return x * (1.0 - x2 * (0.1666666667 - x2 * (0.0083333333 - x2 * (0.0001984127 - x2 * (0.0000027557 - x2 * 0.0000000209)))));
+            };
+            for (int i = 0; i < n; ++i, ++pos) {
+                const double dt = sweepHz(pos) / sampleRate;
+                const double dts[3] = { dt * 8.0, dt, 50.0 / sampleRate };
+                float sum = 0.0f;
+                for (int v = 0; v < numVoices; ++v)
+                    for (int layer = 0; layer < 3; ++layer) {
+                        auto& ph = phases[(size_t)(v * 3 + layer)];
+                        sum += (float)ultraPureSine(ph) * 0.3f;
+                        ph += twoPi * dts[layer]; if (ph >= twoPi) ph -= twoPi;
+                    }
+                out[i] = sum;
+            }
+        } });
     }
 
-    if (visSize1 > 0) {
-        for (int i = 0; i < visSize1; ++i) visualBuffer[visStart1 + i] = tempVisBuffer[i];
+    // Saturation: the specialized FastMath kernels processBlock uses, at drive 4
+    static const char* satNames[] = { "Soft Tanh", "Hard Clip", "Triode", "Tape", "Transformer", "JFET", "BJT", "Wavefold", "Bitcrush", "Exciter", "Cubic" };
+    static const auto saturationKernels = makeSaturationKernels<true>(std::make_index_sequence<numSatTypes>());
+    for (int s = 0; s < numSatTypes; ++s)
+        kernels.push_back({ juce::String("saturation/") + satNames[s], [this, s, state = SaturationState()](const float* in, float* out, int n) mutable {
+            std::copy(in, in + n, out);
+            (this->*saturationKernels[(size_t)s])(out, n, s, 4.0f, state);
+        } });
+
+    // Attack layer filters: shared-coefficient HP -> LP, coefficients refreshed per chunk as in renderSpan
+    kernels.push_back({ "filter/attack HP+LP", [=, hp = TPTCoeffs(), lp = TPTCoeffs(), s = std::array<float, 4>{}, pos = 0](const float* in, float* out, int n) mutable {
+        hp.update((float)(sweepHz(pos) * 0.1), (float)sampleRate);
+        lp.update((float)(sweepHz(pos) * 8.0), (float)sampleRate);
+        for (int i = 0; i < n; ++i) out[i] = lp.processLowpass(hp.processHighpass(in[i], s[0], s[1]), s[2], s[3]);
+        pos += n;
+    } });
+
+    // Master LPF: the stereo SIMD bank, fixed and retuned every internal chunk as in renderChunkOutput
+    for (bool retune : { false, true }) {
+        auto bank = std::make_shared<StereoLowpassBank>();
+        bank->prepare(sampleRate);
+        bank->setCutoff(8000.0f);
+        kernels.push_back({ retune ? "filter/master LPF (retuned per chunk)" : "filter/master LPF",
+            [=, right = std::vector<float>((size_t)internalChunkSize), pos = 0](const float* in, float* out, int n) mutable {
+            for (int start = 0; start < n; start += internalChunkSize) {
+                const int len = std::min(internalChunkSize, n - start);
+                if (retune) bank->setCutoff((float)(sweepHz(pos) * 10.0));
+                std::copy(in + start, in + start + len, out + start);
+                std::copy(in + start, in + start + len, right.begin());
+                bank->process(out + start, right.data(), len);
+                for (int i = 0; i < len; ++i) out[start + i] += right[(size_t)i];
+                pos += len;
+            }
+        } });
     }
-    if (visSize2 > 0) {
-        for (int i = 0; i < visSize2; ++i) visualBuffer[visStart2 + i] = tempVisBuffer[visSize1 + i];
+
+    // The 4-stage stereo cascade of juce TPT filters it replaces, kept as the baseline
+    juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32)internalChunkSize, 1 };
+    std::array<juce::dsp::StateVariableTPTFilter<float>, 8> cascade;
+    for (auto& f : cascade) { f.prepare(spec); f.setType(juce::dsp::StateVariableTPTFilterType::lowpass); f.setResonance(0.5f); f.setCutoffFrequency(8000.0f); }
+    for (bool retune : { false, true })
+        kernels.push_back({ retune ? "filter/master LPF (retuned per chunk, juce SVF, before)" : "filter/master LPF (juce SVF, before)", [=, pos = 0](const float* in, float* out, int n) mutable {
+            for (int i = 0; i < n; ++i, ++pos) {
+                if (retune && pos % internalChunkSize == 0) for (auto& f : cascade) f.setCutoffFrequency((float)(sweepHz(pos) * 10.0));
+                float l = in[i], r = in[i];
+                for (int k = 0; k < 4; ++k) l = cascade[(size_t)k].processSample(0, l);
+                for (int k = 4; k < 8; ++k) r = cascade[(size_t)k].processSample(0, r);
+                out[i] = l + r;
+            }
+        } });
+
+    // Limiter detectors over a 5 ms lookahead: sample peak, and true peak in front of it
+    const int lookahead = (int)(0.005 * sampleRate);
+    for (bool truePeak : { false, true }) {
+        auto window = std::make_shared<SlidingMaxWindow>();
+        window->prepare(limBufferSize);
+        kernels.push_back({ truePeak ? "limiter/true peak detector" : "limiter/sample peak detector",
+            [=, interpolator = TruePeakInterpolator(), ring = std::array<float, limBufferSize>{}, w = 0](const float* in, float* out, int n) mutable {
+            for (int i = 0; i < n; ++i) {
+                ring[(size_t)w] = in[i];
+                const float detected = truePeak ? interpolator.process([&ring, w](int k) { return ring[(size_t)((w - k) & limMask)]; }) : std::abs(in[i]);
+                out[i] = window->push(detected, lookahead + 1);
+                w = (w + 1) & limMask;
+            }
+        } });
     }
-    visualFifo.finishedWrite(visSize1 + visSize2);
+
+    return kernels;
 }
+#endif
 
 const juce::String NextGenKickAudioProcessor::getName() const { return JucePlugin_Name; }
 bool NextGenKickAudioProcessor::acceptsMidi() const { return true; }
@@ -821,11 +1554,16 @@ bool NextGenKickAudioProcessor::isMidiEffect() const { return false; }
 double NextGenKickAudioProcessor::getTailLengthSeconds() const { return 0.0; }
 int NextGenKickAudioProcessor::getNumPrograms() { return 1; }
 int NextGenKickAudioProcessor::getCurrentProgram() { return 0; }
-void NextGenKickAudioProcessor::setCurrentProgram(int index) {}
-const juce::String NextGenKickAudioProcessor::getProgramName(int index) { return {}; }
-void NextGenKickAudioProcessor::changeProgramName(int index, const juce::String& newName) {}
+void NextGenKickAudioProcessor::setCurrentProgram(int) {}
+const juce::String NextGenKickAudioProcessor::getProgramName(int) { return {}; }
+void NextGenKickAudioProcessor::changeProgramName(int, const juce::String&) {}
+#if NGK_HEADLESS
+bool NextGenKickAudioProcessor::hasEditor() const { return false; }
+juce::AudioProcessorEditor* NextGenKickAudioProcessor::createEditor() { return nullptr; }
+#else
 bool NextGenKickAudioProcessor::hasEditor() const { return true; }
 juce::AudioProcessorEditor* NextGenKickAudioProcessor::createEditor() { return new NextGenKickAudioProcessorEditor(*this); }
+#endif
 void NextGenKickAudioProcessor::getStateInformation(juce::MemoryBlock& destData) { auto state = apvts.copyState(); std::unique_ptr<juce::XmlElement> xml(state.createXml()); copyXmlToBinary(*xml, destData); }
 void NextGenKickAudioProcessor::setStateInformation(const void* data, int sizeInBytes) { std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes)); if (xmlState.get() != nullptr) apvts.replaceState(juce::ValueTree::fromXml(*xmlState)); }
 void NextGenKickAudioProcessor::releaseResources() {}
@@ -4,25 +4,39 @@
 #include <algorithm>
 #include <cmath>
 #include <atomic>
-#include <mutex>
 #include <array>
+#include <utility>
+#include <bitset>
+#include "KickVoicePool.h"
+#include "SmoothedBlockParam.h"
+#include "FastMath.h"
+#include "PeakDetectors.h"
+#include "StemCache.h"
+#include "StaticPreview.h"
+#include "NoiseGenerator.h"
+#include "MeterStream.h"
+#include "WavetableBank.h"
+#include "StereoFilterBank.h"
+#include "ParameterTable.h"
+
+// Headless builds (e.g. the batch renderer) compile the processor without the editor
+#ifndef NGK_HEADLESS
+#define NGK_HEADLESS 0
+#endif
+
+#ifndef JucePlugin_Name
+#define JucePlugin_Name "NextGenKick"
+#endif
 
 // --- Preset Structure ---
+// Plain values indexed by ParamId, starting from the table defaults; loading applies the ones
+// the table marks inPreset
 struct PresetData {
     juce::String name;
-    // Attack
-    int atkWave; float atkLevel, atkDecay, atkCurve, atkTone, atkHPF, atkPan, atkPitch, atkPW;
-    // Body
-    int bodyWave; float bodyLevel, pStart, pEnd, pDecay, pCurve, pGlide, bDecay, bCurve, bRatio, bFilter, bPan;
-    // Sub
-    bool subTrack;
-    // subMode Removed
-    float subNote, subFine, subLevel, subDecay, subCurve, subPhase, subAntiClick, subPan;
-    // Master
-    int satType;
-    int osMode;
-    float mDrive, mOut, mWidth, mRelease, mPhase, limThresh, limLook;
-    float mLPF;
+    std::array<float, numParams> values = paramDefaults();
+
+    float operator[](ParamId p) const noexcept { return values[(size_t)p]; }
+    float& operator[](ParamId p) noexcept { return values[(size_t)p]; }
 };
 
 // --- Saturation State with ADAA ---
@@ -40,7 +54,7 @@ struct SaturationState {
     }
 };
 
-class NextGenKickAudioProcessor : public juce::AudioProcessor
+class NextGenKickAudioProcessor : public juce::AudioProcessor, private juce::Timer
 {
 public:
     NextGenKickAudioProcessor();
@@ -70,19 +84,21 @@ public:
     juce::AudioProcessorValueTreeState apvts;
 
     // --- Visualization ---
-    static constexpr int visualBufferSize = 1024;
-    std::vector<float> visualBuffer;
-    juce::AbstractFifo visualFifo{ visualBufferSize };
+    // Output summaries for the meter and the realtime scope, written per chunk by the audio thread
+    MeterStream meterStream;
 
-    static constexpr int fullWaveSize = 22050;
-    std::vector<float> fullWaveAtk;
-    std::vector<float> fullWaveBody;
-    std::vector<float> fullWaveSub;
-    std::atomic<int> fullWaveWriteIdx{ 0 };
-    std::atomic<bool> isRecordingFullWave{ false };
+    // Static preview (message thread): pullStaticPreview() is true when a newer frame arrived
+    bool pullStaticPreview() noexcept { return staticPreview.pull(); }
+    const PreviewFrame& getStaticPreview() const noexcept { return staticPreview.getFrame(); }
+    // Nothing draws the preview without an editor, so the editor switches its rendering on and off
+    void setStaticPreviewActive(bool active) { if (active) staticPreview.start(); else staticPreview.stop(); }
 
     // GUI Parameters (Public)
-    int lastMidiNote = 29;
+    std::atomic<int> lastMidiNote{ 29 };
+    std::atomic<juce::uint32> noteOnCount{ 0 }; // lets an idle editor notice new notes
+
+    // Current plain value of a parameter (any thread)
+    float parameterValue(ParamId p) const noexcept { return paramRaw[(size_t)p]->load(); }
 
     // --- Preset & Randomization ---
     std::vector<PresetData> presetList;
@@ -93,43 +109,87 @@ public:
     void saveUserPreset(const juce::File& file);
     void loadUserPreset(const juce::File& file);
 
+    // --- Benchmarking ---
+    // false routes every block through the generic (run-time dispatched) kernels
+    std::atomic<bool> useSpecializedKernels{ true };
+    // false uses the exact std:: curves in the saturation stage instead of FastMath
+    std::atomic<bool> useFastSaturationMath{ true };
+    // false synthesizes every layer live (no pre-rendered stems)
+    std::atomic<bool> useStemCache{ true };
+    // false runs the whole post-voice chain on silence too (no idle bypass)
+    std::atomic<bool> useIdleBypass{ true };
+    // false applies presets and randomization value by value (ID lookups, every value notified)
+    std::atomic<bool> useBatchedParameterChanges{ true };
+    // Non-zero: prepareToPlay restarts the noise attacks from this seed, so renders repeat exactly
+    std::atomic<juce::int64> noiseSeed{ 0 };
+
+#if NGK_HEADLESS
+    // Inner kernels on their own, for the benchmark suite. Each call processes up to one internal
+    // chunk, keeping its state between calls (oscillators ignore `in`).
+    struct KernelBenchmark {
+        juce::String name;
+        std::function<void(const float* in, float* out, int numSamples)> process;
+    };
+    std::vector<KernelBenchmark> makeKernelBenchmarks(double sampleRate);
+#endif
+
 private:
     float currentSampleRate = 44100.0f;
-    std::atomic<bool> isNoteActive{ false };
-    double noteOnTime = 0.0;
+    std::atomic<float> previewSampleRate{ 44100.0f }; // currentSampleRate, for the preview thread
+    std::atomic<bool> isNoteActive{ false }; // any voice sounding
 
-    double phaseAtk = 0.0;
-    double phaseBody = 0.0;
-    double phaseSub = 0.0;
+    // --- Voice Pool ---
+    KickVoicePool voices;
+    std::vector<float> voiceAtk, voiceBody, voiceSub; // per-voice scratch for one sample
+    std::vector<char> voiceDone;
 
-    juce::Random random;
-    int crCounter = 0;
+    juce::Random random; // preset randomization (message thread)
+    juce::SharedResourcePointer<WavetableBank> wavetables; // band-limited attack/body shapes, shared by every instance
+    NoiseGenerator noise; // noise attacks (audio thread)
+    std::vector<float> noiseBlock; // one span of noise for every voice
 
-    float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0, lastBrown = 0;
-    float spareNoise = 0.0f;
-    bool hasSpareNoise = false;
+    // --- TPT Filters (per-voice layer filters share coefficients) ---
+    TPTCoeffs coefAtkHP, coefAtkLP, coefBodyLP;
 
-    // --- TPT Filters ---
-    juce::dsp::StateVariableTPTFilter<float> filterAtkHP;
-    juce::dsp::StateVariableTPTFilter<float> filterAtkLP;
-    juce::dsp::StateVariableTPTFilter<float> filterBodyLP;
+    // --- Envelope coefficients (per-voice states live in the pool) ---
+    PowerDecayEnvelope atkEnv;
+    ExpDecayEnvelope pitchEnv, bodyEnv, subEnv;
+    RaisedCosineFade subFade;
 
     // Master LPF (Stereo, 4-stage cascade = 48dB/oct)
-    std::array<juce::dsp::StateVariableTPTFilter<float>, 4> filterMasterLP_L;
-    std::array<juce::dsp::StateVariableTPTFilter<float>, 4> filterMasterLP_R;
+    StereoLowpassBank masterLowpass;
+    static constexpr float masterLPFOffHz = 19950.0f; // at or above: the cascade is bypassed
+
+    // --- Internal Chunking ---
+    // Host blocks are cut into chunks of at most internalChunkSize samples. Control-rate work
+    // (smoother targets, filter coefficients, limiter threshold) runs once per chunk, and every
+    // working buffer is sized to one chunk, so it stays in L1 whatever block size the host sends.
+    static constexpr int internalChunkSize = 64;
 
     // --- Oversampling & Saturation Buffer ---
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
-    std::mutex oversamplerMutex;
-    int currentOsMode = -1;
-    int currentReportedLatency = 0; // Latency change detection
+    // One instance per factor, all built in prepareToPlay (index = osMode, Off has none)
+    static constexpr int numOsModes = 4;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, numOsModes> oversamplers;
+    int currentOsMode = 0;
 
-    juce::AudioBuffer<float> satBuffer;
+    // Latency (OS + limiter lookahead): the audio thread only publishes it, the message thread
+    // reports it to the host (setLatencySamples may lock or allocate in the wrapper)
+    std::atomic<int> pendingLatency{ 0 };
+    void timerCallback() override;
 
-    // Saturation States (per channel)
-    std::vector<SaturationState> satStates;
+    // Mode-change crossfade: the outgoing mode keeps running on a copy of the input
+    static constexpr double osFadeSeconds = 0.005;
+    int fadeOsMode = -1; // < 0: no crossfade running
+    int osFadeLength = 256, osFadePos = 0;
+
+    juce::AudioBuffer<float> satBuffer, osFadeBuffer;
+
+    // Saturation States (per channel; the fade set belongs to the outgoing mode)
+    std::array<SaturationState, 2> satStates, fadeSatStates;
+
+    // Last smoothed master values, read by the post-voice chain
+    float masterDriveVal = 1.0f, masterOutVal = 0.0f, limThresholdDB = 0.0f, masterLPFVal = 20000.0f;
 
-    int subAttackCounter = 0;
     float lastMixL = 0.0f, lastMixR = 0.0f;
     float dcLastInL = 0, dcLastOutL = 0, dcLastInR = 0, dcLastOutR = 0;
 
@@ -139,29 +199,143 @@ private:
     std::vector<float> limBufferL;
     std::vector<float> limBufferR;
     int limWriteIdx = 0;
-    float cachedPeak = 0.0f;
-    int cachedPeakIdx = -1;
+    SlidingMaxWindow limPeakWindow;     // detector peak over the lookahead window
+    TruePeakInterpolator truePeakDetector;
+    bool limTruePeak = false;           // per block; the audio path then lags by TruePeakInterpolator::delay
+
+    // --- Idle Bypass ---
+    // Once no voice plays, a whole limiter ring's worth of samples has entered it below silenceThreshold
+    // and the output is below it too, every chain state is flushed to zero and chunks skip the chain.
+    // Zeros through zero states give zeros and leave the states at zero, so a note-on resumes exactly.
+    static constexpr float silenceThreshold = 1.0e-7f; // about -140 dBFS, below 24-bit resolution
+    int quietSamples = 0; // samples in a row entering the limiter ring below silenceThreshold (capped)
+    bool chainIdle = false;
+    void flushChain() noexcept;
+    void renderIdleChunk(float* outL, float* outR, int numSamples) noexcept;
+
+    // --- Layer Output Buses ---
+    // Optional stereo buses after the main output carry each layer's filtered, panned signal, taken
+    // from the same voice pass as the main mix. Pre Master: as it enters the master section. Post
+    // Master: through its linear stages, i.e. the drive stage's small-signal gain, volume, hi-cut,
+    // width, the main limiter's gain and the DC blocker. Saturation stays on the main mix: per layer
+    // it would no longer add up to the main output and would triple the oversampling cost. Both modes
+    // are delayed by the reported latency, so the buses line up with the main output.
+    enum LayerOutMode { layerOutPreMaster, layerOutPostMaster };
+    static constexpr int numLayerBuses = numStemLayers;     // attack, body, sub (bus 1 + layer)
+    static constexpr int numLayerChannels = 2 * numLayerBuses;
+    bool layerBusesActive = false;                          // per block: any layer bus enabled
+    int layerDelay = 0;                                     // per block: the latency the main output reports
+    juce::AudioBuffer<float> layerBuffer;                   // one chunk of the layer mixes, L/R per layer
+    std::array<float*, numLayerChannels> layerSpan{};       // renderSpan's destination in layerBuffer
+    std::array<float*, numLayerChannels> layerOut{};        // current chunk of the bus outputs (nullptr: bus off)
+    std::array<float, numLayerChannels> lastLayerMix{};
+    std::array<std::vector<float>, numLayerChannels> layerRing; // latency delay, indexed like the limiter ring
+    std::array<StereoLowpassBank, numLayerBuses> layerLowpass;
+    std::array<float, numLayerChannels> layerDcIn{}, layerDcOut{};
+    std::vector<float> monoFoldBuffer;                      // right channel of a mono main output
 
     // --- Smoothed Parameters ---
-    juce::LinearSmoothedValue<float> s_atkDecay, s_atkCurve, s_atkTone, s_atkLevel, s_atkPan, s_atkPitch, s_atkHPF, s_atkPW;
-    juce::LinearSmoothedValue<float> s_pStart, s_pEnd, s_pDecay, s_pGlide, s_pCurve, s_bodyDecay, s_bodyCurve, s_bodyLevel, s_bodyPan, s_besselRatio, s_bodyFilter;
-    juce::LinearSmoothedValue<float> s_subNote, s_subFine, s_subDecay, s_subCurve, s_subLevel, s_subPhase, s_subAntiClick, s_subPan;
-    juce::LinearSmoothedValue<float> s_masterDrive, s_masterOut, s_masterWidth, s_masterRelease, s_masterPhase, s_limThreshold, s_masterLPF;
+    // Every parameter's value, resolved once at construction (the audio thread never looks up IDs)
+    std::array<std::atomic<float>*, numParams> paramRaw{};
+    std::array<juce::RangedAudioParameter*, numParams> paramObjects{};
+
+    // Read by the voice loop: ramped per span into contiguous arrays (order matches voiceParamSources)
+    enum VoiceParam {
+        vpAtkDecay, vpAtkCurve, vpAtkTone, vpAtkLevel, vpAtkPan, vpAtkPitch, vpAtkHPF, vpAtkPW,
+        vpPStart, vpPEnd, vpPDecay, vpPGlide, vpPCurve, vpBodyDecay, vpBodyCurve, vpBodyLevel, vpBodyPan, vpBesselRatio, vpBodyFilter,
+        vpSubNote, vpSubFine, vpSubDecay, vpSubCurve, vpSubLevel, vpSubAntiClick, vpSubPan,
+        vpMasterDrive, vpMasterOut, vpMasterRelease, vpLimThreshold, vpMasterLPF,
+        numVoiceParams
+    };
+    std::array<SmoothedBlockParam, numVoiceParams> voiceParams;
+    std::array<std::atomic<float>*, numVoiceParams> voiceParamRaw{};
+
+    // Consumed outside the voice loop (per sample in the output stage, or once at note-on)
+    juce::LinearSmoothedValue<float> s_subPhase, s_masterWidth, s_masterPhase;
+
+    // Block-constant settings, read once per processBlock (order matches blockParamSources)
+    enum BlockParam { bpSatType, bpAtkWave, bpBodyWave, bpSubTrack, bpPolyphony, bpVoiceSteal, bpOsMode, bpLimLookahead, bpLimTruePeak, bpLayerOutMode, numBlockParams };
+    std::array<std::atomic<float>*, numBlockParams> blockParamRaw{};
+    float blockParam(BlockParam p) const noexcept { return blockParamRaw[(size_t)p]->load(); }
+
+    // --- Batched Parameter Changes ---
+    // Preset loads and randomization set many parameters at once. A batch is one undo transaction;
+    // the parameters it actually changes are notified inside one coalesced gesture, unchanged ones
+    // not at all.
+    struct ParameterBatch {
+        std::array<float, numParams> values{}; // plain (denormalized) values
+        std::bitset<numParams> used;
+        std::array<ParamId, numParams> order{}; // first-set order, replayed by the value-by-value path
+        int numSet = 0;
+        void set(ParamId p, float value) noexcept {
+            if (!used[(size_t)p]) order[(size_t)numSet++] = p;
+            values[(size_t)p] = value;
+            used.set((size_t)p);
+        }
+    };
+    void applyParameterBatch(const ParameterBatch& batch, const juce::String& transactionName);
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     void initPresets();
 
-    inline double generateUltraPureSine(double phase) noexcept;
-    inline double polyBlep(double t, double dt) noexcept;
-    float getPinkNoise() noexcept;
+    static constexpr int atkSineWave = 7, bodySineWave = 0; // "Ultra Sine": rendered in the oscillator core's lanes
+    static inline double atkOscillator(const WavetableBank& tables, int aWav, juce::uint32 phase, double dtA, float pulseWidth) noexcept; // atkWave >= 3
+    static inline double bodyOscillator(const WavetableBank& tables, int bWav, juce::uint32 phase, double dtB, float besselRatio) noexcept;
+    static inline double generateUltraPureSine(double phase) noexcept; // the Bessel partials
+
+    // ADAA functions (Type = -1: curve chosen from `type` at run time; Fast: FastMath curves)
+    template <int Type, bool Fast> inline float calcADAAFunc(float x, int type) noexcept;
+    template <int Type, bool Fast> inline float saturateDriven(float x, int type, float drive, SaturationState& state) noexcept;
+
+    // Block-constant voice settings, read once per processBlock
+    struct VoiceBlockContext {
+        int aWav = 0, bWav = 0, polyphony = 1;
+        bool sTra = false;
+        VoiceStealMode stealMode = VoiceStealMode::Oldest;
+    };
+
+    void startVoice(int note, const VoiceBlockContext& ctx);
+    void handleMidiEvent(const juce::MidiMessage& msg, const VoiceBlockContext& ctx);
+    void renderVoices(float* satL, float* satR, int startSample, int endSample, const VoiceBlockContext& ctx);
+    void renderChunkOutput(float* outL, float* outR, int numSamples, int satType, int lookaheadSamples, float dcAlpha, bool layersPostMaster);
 
-    // ADAA functions
-    inline float calcADAAFunc(float x, int type) noexcept;
-    float processSaturationSampleADAA(float x, int type, float drive, SaturationState& state);
+    // --- Specialized kernels: one per attack x body waveform and per saturation type ---
+    static constexpr int numAtkWaves = 8, numBodyWaves = 5, numSatTypes = 11;
+    using RenderKernel = void (NextGenKickAudioProcessor::*)(float*, float*, int, const VoiceBlockContext&);
+    using SaturationKernel = void (NextGenKickAudioProcessor::*)(float*, int, int, float, SaturationState&) noexcept;
 
+    template <int AWav, int BWav> void renderSpan(float* satL, float* satR, int numSamples, const VoiceBlockContext& ctx);
+    template <int Type, bool Fast> void saturateBlock(float* p, int numSamples, int type, float drive, SaturationState& state) noexcept;
+    template <size_t... I> static std::array<RenderKernel, sizeof...(I)> makeRenderKernels(std::index_sequence<I...>);
+    template <bool Fast, size_t... I> static std::array<SaturationKernel, sizeof...(I)> makeSaturationKernels(std::index_sequence<I...>);
+    void selectKernels(int aWav, int bWav, int satType);
+
+    RenderKernel renderKernel = nullptr;         // chosen once per block
+    SaturationKernel saturationKernel = nullptr;
     void updateParameters();
-    void updateOversampler(int mode, int samplesPerBlock);
-    void updateLatency(int lookaheadSamples);
+
+    // --- Stem Cache ---
+    static int stemLayerOf(int voiceParam) noexcept; // -1: not part of any stem (level, pan, master)
+    static juce::uint64 stemKey(const StemRequest& r) noexcept;
+    static void renderStem(const StemRequest& r, CachedStem& stem);
+    void attachStems(int v, const VoiceBlockContext& ctx);
+    void advanceStems(int v, float atkLevel, float bodyLevel) noexcept;
+
+    // --- Static Preview ---
+    StemRequest takePreviewSnapshot() const;
+    static void renderPreview(const StemRequest& snapshot, PreviewFrame& frame);
+
+    void prepareOversamplers(int maxBlockSize);
+    void switchOversampler(int mode);
+    void saturateOversampled(int mode, juce::dsp::AudioBlock<float> block, std::array<SaturationState, 2>& states, int satType);
+    int getLookaheadSamples() const noexcept;
+    int computeLatency(int lookaheadSamples, bool truePeak) const noexcept;
+
+    // Pre-rendered layer stems, rendered on a shared background thread (voices reference them through the pool)
+    StemCache stemCache{ &NextGenKickAudioProcessor::renderStem };
+
+    // Last member: destroyed first, so the preview thread stops reading parameters before anything else goes
+    StaticPreview staticPreview{ [this] { return takePreviewSnapshot(); }, &NextGenKickAudioProcessor::renderPreview };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NextGenKickAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// --- Block-Rate Parameter Smoothing ---
+// A moving parameter fills a contiguous ramp for the current block; a settled one collapses
+// to a single scalar read with stride 0. The render loop indexes both the same way: p[i].
+struct SmoothedBlockParam {
+    SmoothedBlockParam() = default;
+
+    void prepare(double sampleRate, double rampSeconds, int maxBlockSize) {
+        ramp.assign((size_t)maxBlockSize, 0.0f);
+        smoother.reset(sampleRate, rampSeconds);
+        settle();
+    }
+
+    void setTargetValue(float v) noexcept { smoother.setTargetValue(v); }
+    float getTargetValue() const noexcept { return smoother.getTargetValue(); }
+    float getCurrentValue() const noexcept { return smoother.getCurrentValue(); }
+    bool isRamping() const noexcept { return stride != 0; }
+    bool isSmoothing() const noexcept { return smoother.isSmoothing(); } // target not reached yet
+
+    // Prepares values for the next numSamples (<= maxBlockSize given to prepare)
+    void process(int numSamples) noexcept {
+        if (!smoother.isSmoothing()) { settle(); return; }
+        for (int i = 0; i < numSamples; ++i) ramp[(size_t)i] = smoother.getNextValue();
+        data = ramp.data();
+        stride = 1;
+    }
+
+    // Advances without producing values (nothing reads this block)
+    void skip(int numSamples) noexcept {
+        if (smoother.isSmoothing()) smoother.skip(numSamples);
+        settle();
+    }
+
+    inline float operator[](int i) const noexcept { return data[i * stride]; }
+
+private:
+    void settle() noexcept {
+        scalar = smoother.getCurrentValue();
+        data = &scalar;
+        stride = 0;
+    }
+
+    juce::LinearSmoothedValue<float> smoother;
+    std::vector<float> ramp;
+    float scalar = 0.0f;
+    const float* data = &scalar;
+    int stride = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(SmoothedBlockParam)
+};
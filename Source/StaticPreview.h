@@ -0,0 +1,145 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include "StemCache.h"
+
+// --- Static Preview ---
+// The editor's layer preview is rendered on the stem render thread whenever the parameters it
+// depends on change, and handed to the message thread through a triple buffer.
+
+// Min/max over power-of-two buckets: level k covers 2^k samples per bucket, so any span is
+// answered from a handful of buckets whatever its length.
+struct MinMaxPyramid {
+    void build(const float* samples, int numSamples) {
+        length = numSamples;
+        int numLevels = 1;
+        while ((1 << (numLevels - 1)) < numSamples) ++numLevels;
+        mins.resize((size_t)numLevels);
+        maxs.resize((size_t)numLevels);
+
+        mins[0].assign(samples, samples + numSamples);
+        maxs[0].assign(samples, samples + numSamples);
+        for (int k = 1; k < numLevels; ++k) {
+            const auto& lo = mins[(size_t)k - 1];
+            const auto& hi = maxs[(size_t)k - 1];
+            const size_t n = (lo.size() + 1) / 2;
+            mins[(size_t)k].resize(n);
+            maxs[(size_t)k].resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                const size_t j = std::min(2 * i + 1, lo.size() - 1);
+                mins[(size_t)k][i] = std::min(lo[2 * i], lo[j]);
+                maxs[(size_t)k][i] = std::max(hi[2 * i], hi[j]);
+            }
+        }
+    }
+
+    int getLength() const noexcept { return length; }
+
+    // Min and max over [start, end), widened to whole buckets of the coarsest level that fits
+    juce::Range<float> getRange(int start, int end) const noexcept {
+        start = juce::jlimit(0, length - 1, start);
+        end = juce::jlimit(start + 1, length, end);
+
+        int k = 0;
+        while (k + 1 < (int)mins.size() && (2 << k) <= end - start) ++k;
+        const auto& lo = mins[(size_t)k];
+        const auto& hi = maxs[(size_t)k];
+
+        float mn = lo[(size_t)(start >> k)], mx = hi[(size_t)(start >> k)];
+        for (int b = (start >> k) + 1; b <= (end - 1) >> k; ++b) {
+            mn = std::min(mn, lo[(size_t)b]);
+            mx = std::max(mx, hi[(size_t)b]);
+        }
+        return { mn, mx };
+    }
+
+private:
+    std::vector<std::vector<float>> mins, maxs; // [level][bucket]
+    int length = 0;
+};
+
+// Single producer, single consumer, neither side ever waits: the writer fills its own buffer and
+// swaps it into the middle slot; the reader swaps the middle out only when something new is there.
+template <typename T>
+class TripleBuffer {
+public:
+    T& getWriteBuffer() noexcept { return buffers[(size_t)back]; }
+    void publish() noexcept { back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask; }
+
+    // Reader: takes the latest published buffer, if any; returns false if nothing new arrived
+    bool pull() noexcept {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return buffers[(size_t)front]; }
+
+private:
+    static constexpr int indexMask = 3, freshBit = 4;
+    std::array<T, 3> buffers;
+    int front = 0, back = 1;     // owned by the reader / the writer
+    std::atomic<int> middle{ 2 };
+};
+
+struct PreviewFrame {
+    std::array<MinMaxPyramid, numStemLayers> layers; // each layer at its current level
+    bool valid = false;
+};
+
+// Polls a parameter snapshot on the render thread and re-renders only when it differs
+class StaticPreview : private juce::TimeSliceClient {
+public:
+    static constexpr int numSamples = 22050;
+    static constexpr int pollIntervalMs = 30;
+
+    using Snapshot = std::function<StemRequest()>;
+    using Renderer = std::function<void(const StemRequest&, PreviewFrame&)>;
+
+    StaticPreview(Snapshot takeSnapshot, Renderer renderFrame)
+        : snapshot(std::move(takeSnapshot)), renderer(std::move(renderFrame)) {}
+
+    ~StaticPreview() override { renderThread->removeTimeSliceClient(this); }
+
+    // Once everything the snapshot reads is set up; stop() keeps the last frame
+    void start() { renderThread->addTimeSliceClient(this); }
+    void stop() { renderThread->removeTimeSliceClient(this); }
+
+    // Message thread: true when a newer frame replaced the one returned by getFrame()
+    bool pull() noexcept { return frames.pull(); }
+    const PreviewFrame& getFrame() const noexcept { return frames.getReadBuffer(); }
+
+private:
+    int useTimeSlice() override {
+        const StemRequest current = snapshot();
+        if (hasRendered && sameSettings(current, lastRendered)) return pollIntervalMs;
+
+        auto& frame = frames.getWriteBuffer();
+        renderer(current, frame);
+        frame.valid = true;
+        frames.publish();
+
+        lastRendered = current;
+        hasRendered = true;
+        return pollIntervalMs;
+    }
+
+    static bool sameSettings(const StemRequest& a, const StemRequest& b) noexcept {
+        return a.params == b.params && a.aWav == b.aWav && a.bWav == b.bWav && a.note == b.note && a.sTra == b.sTra
+            && a.sampleRate == b.sampleRate && a.startPhase == b.startPhase && a.subStartPhase == b.subStartPhase;
+    }
+
+    Snapshot snapshot;
+    Renderer renderer;
+    juce::SharedResourcePointer<StemRenderThread> renderThread;
+
+    TripleBuffer<PreviewFrame> frames;
+    StemRequest lastRendered; // render thread only
+    bool hasRendered = false;
+
+    JUCE_DECLARE_NON_COPYABLE(StaticPreview)
+};
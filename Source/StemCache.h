@@ -0,0 +1,187 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include "EnvelopeGenerators.h"
+
+// --- Pre-rendered Layer Stems ---
+// Apart from the noise attacks, a layer is a deterministic function of its parameters (and, for a
+// key-tracked sub, of the note). A stem holds the first seconds of one layer of one voice at level 1,
+// rendered in the background. A voice whose layer parameters are settled at note-on plays the stem
+// instead of synthesizing; level and pan stay live. At the end of the stem the layer either goes
+// silent (it has decayed below -100 dB) or hands its end state over to live synthesis.
+enum StemLayer { layerAtk, layerBody, layerSub, numStemLayers };
+
+// Voice state right after the last stem sample (only the fields of the stem's layer are used)
+struct StemEndState {
+    juce::uint32 phase = 0; // fixed point, see LayerOscillatorCore
+    PowerDecayEnvelope::State envAtk;
+    double envPitch = 1.0, env = 1.0;
+    RaisedCosineFade::State fade;
+    std::array<float, 4> filter{}; // Atk: HP1, HP2, LP1, LP2; Body: LP1, LP2 (at level 1)
+};
+
+struct CachedStem {
+    static constexpr int envelopeDecimation = 16;
+    static constexpr double maxSeconds = 2.0; // below the shortest masterRelease, so no voice ends inside a stem
+
+    juce::uint64 key = 0;
+    std::vector<float> samples;  // layer output at level 1
+    std::vector<float> envelope; // amplitude envelope every envelopeDecimation samples (voice level, release check)
+    bool silentAfter = false;    // true: silent past the end; false: hand over `end` to live synthesis
+    StemEndState end;
+
+    // Voices playing it and the last note-on that picked it; written by the audio thread only
+    mutable std::atomic<int> users{ 0 };
+    mutable std::atomic<juce::uint32> lastUsed{ 0 };
+
+    int length() const noexcept { return (int)samples.size(); }
+    bool playsAt(int pos) const noexcept { return pos < length() || silentAfter; }
+    float sampleAt(int pos) const noexcept { return pos < length() ? samples[(size_t)pos] : 0.0f; }
+    float envelopeAt(int pos) const noexcept { return pos < length() ? envelope[(size_t)(pos / envelopeDecimation)] : 0.0f; }
+
+    static void release(const CachedStem* stem) noexcept { if (stem != nullptr) stem->users.fetch_sub(1, std::memory_order_release); }
+};
+
+// Everything the renderer needs, copied at note-on so the background thread never reads live state
+struct StemRequest {
+    static constexpr int maxParams = 32;
+
+    int layer = 0;
+    int maxLength = 0; // samples; 0: CachedStem::maxSeconds
+    juce::uint64 key = 0;
+    std::array<float, maxParams> params{};
+    int aWav = 0, bWav = 0, note = 0;
+    bool sTra = false;
+    double sampleRate = 44100.0;
+    juce::uint32 startPhase = 0, subStartPhase = 0;
+};
+
+// One background thread renders stems for every plugin instance in the process
+struct StemRenderThread : public juce::TimeSliceThread {
+    StemRenderThread() : juce::TimeSliceThread("NGK Stem Cache") { startThread(); }
+    ~StemRenderThread() override { stopThread(2000); }
+};
+
+// A few stems per layer, published through atomic slots. The audio thread only looks up, counts
+// users and queues requests (no locks, no allocation); rendering, replacement and deletion happen
+// on the render thread. A replaced stem is deleted once no voice uses it and a grace period has
+// passed, which covers a lookup racing with the replacement.
+class StemCache : private juce::TimeSliceClient {
+public:
+    static constexpr int slotsPerLayer = 4;
+    static constexpr int requestQueueSize = 16;
+    static constexpr double retireGraceSeconds = 1.0;
+
+    using Renderer = std::function<void(const StemRequest&, CachedStem&)>;
+
+    explicit StemCache(Renderer stemRenderer) : renderer(std::move(stemRenderer)) {
+        for (auto& layer : slots)
+            for (auto& s : layer) s.store(nullptr);
+        renderThread->addTimeSliceClient(this);
+    }
+
+    ~StemCache() override { renderThread->removeTimeSliceClient(this); }
+
+    // Audio thread: the stem for (layer, key) with the caller counted as a user, or nullptr
+    const CachedStem* acquire(int layer, juce::uint64 key) noexcept {
+        for (auto& slot : slots[(size_t)layer]) {
+            const CachedStem* stem = slot.load(std::memory_order_acquire);
+            if (stem != nullptr && stem->key == key) {
+                stem->users.fetch_add(1, std::memory_order_acquire);
+                stem->lastUsed.store(++useCounter, std::memory_order_relaxed);
+                lastRequested[(size_t)layer] = 0; // it may be evicted later and need rendering again
+                return stem;
+            }
+        }
+        return nullptr;
+    }
+
+    // Audio thread: queues a render (repeats of the last key per layer and a full queue are dropped)
+    void request(const StemRequest& r) noexcept {
+        if (lastRequested[(size_t)r.layer] == r.key) return;
+
+        int start1, size1, start2, size2;
+        requests.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 == 0) return;
+        requestBuffer[(size_t)(size1 > 0 ? start1 : start2)] = r;
+        requests.finishedWrite(1);
+        lastRequested[(size_t)r.layer] = r.key;
+    }
+
+private:
+    int useTimeSlice() override {
+        collectRetired();
+
+        int start1, size1, start2, size2;
+        requests.prepareToRead(1, start1, size1, start2, size2);
+        if (size1 + size2 == 0) return 20;
+
+        const StemRequest r = requestBuffer[(size_t)(size1 > 0 ? start1 : start2)];
+        requests.finishedRead(1);
+
+        auto& layerSlots = slots[(size_t)r.layer];
+        for (auto& slot : layerSlots)
+            if (auto* s = slot.load(std::memory_order_relaxed); s != nullptr && s->key == r.key) return 0;
+
+        auto stem = std::make_unique<CachedStem>();
+        stem->key = r.key;
+        renderer(r, *stem);
+
+        // Replace an empty slot, else the least recently used one (preferring stems nobody plays)
+        auto& layerOwned = owned[(size_t)r.layer];
+        int victim = -1;
+        for (int i = 0; i < slotsPerLayer && victim < 0; ++i)
+            if (layerOwned[(size_t)i] == nullptr) victim = i;
+
+        if (victim < 0) {
+            victim = 0;
+            for (int i = 1; i < slotsPerLayer; ++i) {
+                const auto& a = *layerOwned[(size_t)i];
+                const auto& b = *layerOwned[(size_t)victim];
+                const bool aIdle = a.users.load() == 0, bIdle = b.users.load() == 0;
+                if (aIdle != bIdle ? aIdle : (juce::int32)(a.lastUsed.load() - b.lastUsed.load()) < 0) victim = i; // wrap-safe
+            }
+        }
+
+        layerSlots[(size_t)victim].store(stem.get(), std::memory_order_release);
+        if (layerOwned[(size_t)victim] != nullptr)
+            retired.push_back({ std::move(layerOwned[(size_t)victim]), juce::Time::getMillisecondCounterHiRes() });
+        layerOwned[(size_t)victim] = std::move(stem);
+        return 0;
+    }
+
+    void collectRetired() {
+        const double now = juce::Time::getMillisecondCounterHiRes();
+        retired.erase(std::remove_if(retired.begin(), retired.end(), [now](const RetiredStem& r) {
+            return r.stem->users.load(std::memory_order_acquire) == 0 && now - r.retiredAtMs > retireGraceSeconds * 1000.0;
+        }), retired.end());
+    }
+
+    struct RetiredStem {
+        std::unique_ptr<CachedStem> stem;
+        double retiredAtMs = 0.0;
+    };
+
+    Renderer renderer;
+    juce::SharedResourcePointer<StemRenderThread> renderThread;
+
+    std::array<std::array<std::atomic<const CachedStem*>, slotsPerLayer>, numStemLayers> slots;
+
+    // Audio thread only
+    juce::uint32 useCounter = 0;
+    std::array<juce::uint64, numStemLayers> lastRequested{};
+
+    // Render thread only
+    std::array<std::array<std::unique_ptr<CachedStem>, slotsPerLayer>, numStemLayers> owned;
+    std::vector<RetiredStem> retired;
+
+    juce::AbstractFifo requests{ requestQueueSize };
+    std::array<StemRequest, requestQueueSize> requestBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE(StemCache)
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+// --- Stereo Master Lowpass Bank ---
+// Four TPT SVF lowpass stages at resonance 0.5 (48 dB/oct, the same topology and coefficients as
+// juce::dsp::StateVariableTPTFilter) for both channels, in eight SIMD lanes: L stages 0..3, then R.
+// The stages run as a wavefront: in step t, lane k filters sample t - k from what lane k - 1 made
+// in step t - 1. All lanes advance together, a chunk of n samples takes n + 3 steps, and there is
+// no added latency; lanes outside the chunk keep their state.
+// setCutoff() is the control-rate update (one tan() when the cutoff moves); g and h then ramp
+// linearly over the next chunk, h refined against the ramped g by two Newton steps, so the per-sample
+// loop has no trig and no division. A jump that moves 1 + g by more than maxRampRatio (the smoothed
+// parameter never does) is applied at once, as the juce filters did, which keeps the refined h
+// within 1e-4 of exact. Checked by NextGenKickRender --check-filters.
+class StereoLowpassBank {
+public:
+    static constexpr int numStages = 4;
+    static constexpr int numLanes = 2 * numStages;
+    static constexpr float R2 = 2.0f; // 1 / resonance
+    static constexpr float maxRampRatio = 1.4f;
+
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int vecSize = (int)Vec::SIMDNumElements;
+    static_assert(numLanes % vecSize == 0, "lanes must fill whole registers");
+
+    void prepare(double newSampleRate) noexcept {
+        sampleRate = newSampleRate;
+        cutoff = -1.0f;
+        reset();
+    }
+
+    void reset() noexcept {
+        s1.fill(0.0f);
+        s2.fill(0.0f);
+    }
+
+    // Control rate: ramps over the next process(); the first call after prepare() and big jumps snap
+    void setCutoff(float hz) noexcept {
+        if (hz == cutoff) return;
+        const bool first = cutoff < 0.0f;
+        cutoff = hz;
+        const double gd = std::tan(juce::MathConstants<double>::pi * (double)hz / sampleRate);
+        gTarget = (float)gd;
+        hTarget = (float)(1.0 / (1.0 + R2 * gd + gd * gd));
+        const float ratio = (1.0f + gTarget) / (1.0f + g);
+        if (first || ratio > maxRampRatio || ratio * maxRampRatio < 1.0f) { g = gTarget; h = hTarget; }
+    }
+
+    // Nothing to filter (the idle chain): lands on the target as a process() call would
+    void skip() noexcept {
+        g = gTarget;
+        h = hTarget;
+    }
+
+    // Filters n samples of both channels in place
+    void process(float* left, float* right, int n) noexcept {
+        if (n <= 0) return;
+
+        // Sample j uses g + (j + 1) * dg (and h likewise), reaching the target on the last sample
+        const float dg = (gTarget - g) / (float)n, dh = (hTarget - h) / (float)n;
+        const Vec zero = Vec::expand(0.0f), one = Vec::expand(1.0f), two = Vec::expand(2.0f);
+        const Vec end = Vec::expand((float)n), r2 = Vec::expand(R2);
+        const Vec g0 = Vec::expand(g), h0 = Vec::expand(h), gStep = Vec::expand(dg), hStep = Vec::expand(dh);
+
+        for (int k = 0; k < numLanes; ++k) sample[(size_t)k] = -(float)(k % numStages);
+
+        for (int t = 0; t < n + numStages - 1; ++t) {
+            x[0] = t < n ? left[t] : 0.0f;
+            x[numStages] = t < n ? right[t] : 0.0f;
+            for (int k = 1; k < numStages; ++k) {
+                x[(size_t)k] = y[(size_t)k - 1];
+                x[(size_t)(numStages + k)] = y[(size_t)(numStages + k - 1)];
+            }
+
+            for (int r = 0; r < numLanes; r += vecSize) {
+                const Vec j = Vec::fromRawArray(sample.data() + r);
+                const auto active = Vec::greaterThanOrEqual(j, zero) & Vec::lessThan(j, end);
+
+                const Vec gv = g0 + (j + one) * gStep;
+                const Vec d = one + gv * (gv + r2); // 1 / h
+                Vec hv = h0 + (j + one) * hStep;
+                hv = hv * (two - hv * d);
+                hv = hv * (two - hv * d);
+
+                const Vec in = Vec::fromRawArray(x.data() + r);
+                const Vec a = Vec::fromRawArray(s1.data() + r), b = Vec::fromRawArray(s2.data() + r);
+                const Vec yHP = hv * (in - a * (gv + r2) - b);
+                const Vec yBP = yHP * gv + a;
+                const Vec yLP = yBP * gv + b;
+
+                (((yHP * gv + yBP) & active) + (a & ~active)).copyToRawArray(s1.data() + r);
+                (((yBP * gv + yLP) & active) + (b & ~active)).copyToRawArray(s2.data() + r);
+                yLP.copyToRawArray(y.data() + r);
+                (j + one).copyToRawArray(sample.data() + r);
+            }
+
+            if (t >= numStages - 1) {
+                left[t - (numStages - 1)] = y[numStages - 1];
+                right[t - (numStages - 1)] = y[numLanes - 1];
+            }
+        }
+
+        g = gTarget;
+        h = hTarget;
+    }
+
+private:
+    double sampleRate = 44100.0;
+    float cutoff = -1.0f;
+    float g = 0.0f, h = 1.0f, gTarget = 0.0f, hTarget = 1.0f;
+
+    // Integrator states per lane, and the step scratch: lane input, lane output, sample index
+    alignas(Vec::SIMDRegisterSize) std::array<float, numLanes> s1{}, s2{};
+    alignas(Vec::SIMDRegisterSize) std::array<float, numLanes> x{}, y{}, sample{};
+};
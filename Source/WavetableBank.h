@@ -0,0 +1,106 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+// --- Band-limited Wavetables ---
+// Saw and square as additive tables, levelsPerOctave mip levels per octave: level k holds the
+// harmonics up to maxHarmonics * 2^(-k / levelsPerOctave) at oversampling or more points per period
+// of the top one. A phase increment of dt cycles per sample blends the two levels just above
+// levelsPerOctave * log2(dt * 2 * maxHarmonics), both of which keep every harmonic below Nyquist.
+// The blend is continuous in dt, so a pitch sweep never jumps between levels; the price is that
+// harmonics in the top quarter octave below Nyquist fade out. 1024 harmonics keep a 20 Hz tone's
+// content up to 20 kHz. Built once per process (SharedResourcePointer), read-only afterwards.
+class WavetableBank {
+public:
+    enum Shape { saw, square, numShapes };
+    static constexpr int maxHarmonics = 1024;
+    static constexpr int levelsPerOctave = 4;
+    static constexpr int numLevels = 10 * levelsPerOctave + 1; // 1024 harmonics down to 1
+    static constexpr int oversampling = 8;   // minimum table points per period of the top harmonic
+    static constexpr int minTableSize = 64;
+
+    // Two neighbouring levels and how far to go from the first to the second
+    struct Mip {
+        int level = 0;
+        float fade = 0.0f;
+    };
+
+    WavetableBank() {
+        for (int level = 0; level < numLevels; ++level) {
+            const int harmonics = harmonicsAt(level);
+            int size = minTableSize;
+            while (size < oversampling * harmonics) size *= 2;
+            const auto sines = sineCycle(size);
+            const double pi = juce::MathConstants<double>::pi;
+
+            // saw 2t - 1, as in the naive shape; the square (t < 0.5 ? 1 : -1) is saw(t + 1/2) - saw(t),
+            // which cancels the even harmonics
+            std::array<std::vector<double>, numShapes> sums;
+            for (auto& s : sums) s.assign((size_t)size, 0.0);
+            for (int h = 1; h <= harmonics; ++h)
+                for (int n = 0; n < size; ++n)
+                    sums[saw][(size_t)n] -= 2.0 / (pi * h) * sines[(size_t)((h * n) & (size - 1))];
+            for (int n = 0; n < size; ++n)
+                sums[square][(size_t)n] = sums[saw][(size_t)((n + size / 2) & (size - 1))] - sums[saw][(size_t)n];
+
+            for (int shape = 0; shape < numShapes; ++shape)
+                tables[(size_t)shape][(size_t)level] = withGuards(sums[(size_t)shape]);
+        }
+    }
+
+    // Harmonics held by a level (rounded down, so every level stays below its Nyquist bound)
+    static int harmonicsAt(int level) noexcept {
+        return (int)std::floor(maxHarmonics * std::exp2(-(double)level / levelsPerOctave) + 1.0e-9);
+    }
+
+    // Levels for a phase increment of dt cycles per sample
+    static inline Mip mipFor(double dt) noexcept {
+        // dt * 2 * maxHarmonics = 2m * 2^(e - 1); the quarter octave of 2m in [1, 2) picks the level
+        static constexpr double steps[levelsPerOctave + 1] = { 1.0, 1.189207115002721, 1.414213562373095, 1.681792830507429, 2.0 };
+        int e = 0;
+        const double m2 = 2.0 * std::frexp(dt * (2.0 * maxHarmonics), &e);
+        if (dt <= 0.0 || e <= 0) return { 0, 0.0f };
+        int j = 0;
+        while (j < levelsPerOctave - 1 && m2 >= steps[j + 1]) ++j;
+        const int level = levelsPerOctave * (e - 1) + j + 1;
+        if (level >= numLevels - 1) return { numLevels - 1, 0.0f };
+        return { level, (float)((m2 - steps[j]) / (steps[j + 1] - steps[j])) };
+    }
+
+    // t = phase in cycles, [0, 1)
+    inline float read(Shape shape, double t, Mip mip) const noexcept {
+        const auto& levels = tables[(size_t)shape];
+        const float a = lookup(levels[(size_t)mip.level], t);
+        if (mip.fade == 0.0f) return a;
+        return a + mip.fade * (lookup(levels[(size_t)mip.level + 1], t) - a);
+    }
+
+private:
+    static std::vector<double> sineCycle(int size) {
+        std::vector<double> s((size_t)size);
+        for (int n = 0; n < size; ++n) s[(size_t)n] = std::sin(juce::MathConstants<double>::twoPi * n / size);
+        return s;
+    }
+
+    // Two guard points repeat the start, so the interpolation never wraps
+    static std::vector<float> withGuards(const std::vector<double>& cycle) {
+        std::vector<float> t(cycle.begin(), cycle.end());
+        t.push_back(t[0]);
+        t.push_back(t[1]);
+        return t;
+    }
+
+    static inline float lookup(const std::vector<float>& table, double t) noexcept {
+        const double pos = t * (double)(table.size() - 2);
+        const int i = (int)pos;
+        const float frac = (float)(pos - i);
+        return table[(size_t)i] + frac * (table[(size_t)i + 1] - table[(size_t)i]);
+    }
+
+    std::array<std::array<std::vector<float>, numLevels>, numShapes> tables;
+
+    JUCE_DECLARE_NON_COPYABLE(WavetableBank)
+};
@@ -0,0 +1,65 @@
+#include "RenderModes.h"
+#include "RealtimeAudit.h"
+#include <cmath>
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Real-time safety audit: processBlock must not allocate or lock ---
+// Every preset x OS mode x block size plays two notes; halfway through, the OS mode moves on,
+// so the crossfade and the latency change run under the audit too. Host-side work (parameter
+// changes, MIDI buffer fill) stays outside the audited scope.
+int auditRealtime(const Settings& settings, const juce::String& presetList) {
+    static constexpr int numOsModes = 4;
+    static const int blockSizes[] = { 1, 17, 64, 100, 512, 4096 };
+
+    NextGenKickAudioProcessor proc;
+    const auto presets = parseIndexList(presetList, 0, (int)proc.presetList.size() - 1);
+    const int totalSamples = (int)std::ceil(settings.lengthSeconds * settings.sampleRate);
+    const int switchPos = totalSamples / 2;
+
+    juce::AudioBuffer<float> block(2, 4096);
+    juce::MidiBuffer midi;
+    midi.ensureSize(256);
+
+    int numRuns = 0, numFailed = 0;
+    for (int p : presets)
+        for (int os = 0; os < numOsModes; ++os)
+            for (int blockSize : blockSizes) {
+                setUpOffline(proc, settings.sampleRate, blockSize, p);
+                proc.useStemCache = true; // stems played from the cache have to be real-time safe too
+                setParameter(proc, pOsMode, (float)os);
+                proc.prepareToPlay(settings.sampleRate, blockSize);
+                RealtimeAudit::resetCounts();
+
+                for (int pos = 0; pos < totalSamples; pos += blockSize) {
+                    const int n = juce::jmin(blockSize, totalSamples - pos);
+                    block.setSize(2, n, false, false, true);
+                    block.clear();
+                    midi.clear();
+                    if (pos == 0) midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), 0);
+                    if (pos <= switchPos && switchPos < pos + n) {
+                        midi.addEvent(juce::MidiMessage::noteOn(1, 41, (juce::uint8)100), switchPos - pos);
+                        setParameter(proc, pOsMode, (float)((os + 1) % numOsModes));
+                    }
+
+                    const RealtimeAudit::ScopedAudioThread audioThread;
+                    proc.processBlock(block, midi);
+                }
+
+                const auto counts = RealtimeAudit::getCounts();
+                ++numRuns;
+                if (counts.any()) {
+                    ++numFailed;
+                    std::cout << "preset " << p << " osMode " << os << " block " << blockSize << ": " << counts.allocations << " allocations, "
+                        << counts.deallocations << " frees, " << counts.locks << " locks" << std::endl;
+                }
+            }
+
+    std::cout << numRuns << " runs, " << numFailed << " with audio-thread allocations or locks" << std::endl;
+    if (!RealtimeAudit::canSeeLocks()) std::cout << "(lock calls are not visible on this platform; heap checks only)" << std::endl;
+    std::cout << (numFailed == 0 ? "PASS" : "FAIL") << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,30 @@
+#include "RenderModes.h"
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Block size benchmark: host block sizes 1..8192 against the fixed internal chunk ---
+int benchBlockSizes(const Settings& settings, const juce::String& presetList) {
+    static constexpr int repeats = 3;
+
+    NextGenKickAudioProcessor proc;
+    const auto presets = parseIndexList(presetList, 0, (int)proc.presetList.size() - 1);
+
+    std::cout << "preset\tblock\tns/smp" << std::endl;
+    for (int p : presets) {
+        for (int blockSize = 1; blockSize <= 8192; blockSize *= 2) {
+            Settings s = settings;
+            s.blockSize = blockSize;
+            setUpOffline(proc, s.sampleRate, blockSize, p);
+
+            juce::AudioBuffer<float> block(2, blockSize);
+            juce::MidiBuffer midi;
+            double best = 1.0e30;
+            for (int r = 0; r < repeats; ++r) best = juce::jmin(best, timeOneShot(proc, s, block, midi));
+            std::cout << p << "\t" << blockSize << "\t" << best << std::endl;
+        }
+    }
+    return 0;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,71 @@
+#include "RenderModes.h"
+#include "BenchmarkSuite.h"
+#include "../../Source/PluginEditor.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace RenderModes {
+
+// --- Editor frame-time benchmark: the whole window vs. what a frame actually repaints ---
+// Paints the editor offscreen, one frame per 1/60 s of audio: a kick, its tail, then silence, where
+// the editor should stop repainting. The static preview renders on its thread as in the plugin.
+int benchEditor(const Settings& settings) {
+    static constexpr int frameRate = 60;
+    const int samplesPerFrame = (int)(settings.sampleRate / frameRate);
+    const int numFrames = (int)std::ceil(settings.lengthSeconds * frameRate);
+
+    NextGenKickAudioProcessor proc;
+    setUpOffline(proc, settings.sampleRate, samplesPerFrame, 0);
+    proc.useStemCache = true; // as in the plugin
+    proc.prepareToPlay(settings.sampleRate, samplesPerFrame);
+
+    NextGenKickAudioProcessorEditor editor(proc);
+    editor.setVisible(true);
+    juce::Image canvas(juce::Image::RGB, editor.getWidth(), editor.getHeight(), true);
+    const juce::RectangleList<int> wholeWindow(editor.getLocalBounds());
+
+    auto paintMs = [&](const juce::RectangleList<int>& region) {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        {
+            juce::Graphics g(canvas);
+            g.reduceClipRegion(region);
+            editor.paintEntireComponent(g, false);
+        }
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    };
+
+    const double firstPaint = paintMs(wholeWindow); // includes drawing the background cache
+
+    juce::AudioBuffer<float> block(2, samplesPerFrame);
+    juce::MidiBuffer midi;
+    std::vector<double> wholeMs, frameMs;
+    int idleFrames = 0;
+
+    for (int f = 0; f < numFrames; ++f) {
+        block.clear();
+        midi.clear();
+        if (f == 0) midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), 0);
+        proc.processBlock(block, midi);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        const auto dirty = editor.updateFrame();
+        double ms = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+        if (dirty.isEmpty()) ++idleFrames;
+        else ms += paintMs(dirty);
+        frameMs.push_back(ms);
+
+        wholeMs.push_back(paintMs(wholeWindow));
+    }
+
+    const auto whole = BenchmarkSuite::TimingStats::of(wholeMs), frame = BenchmarkSuite::TimingStats::of(frameMs);
+    std::cout << "first paint (background cache): " << firstPaint << " ms" << std::endl;
+    std::cout << numFrames << " frames, " << idleFrames << " with nothing to repaint" << std::endl;
+    std::cout << "\tmean ms\tp99 ms\tmax ms" << std::endl;
+    std::cout << "whole window\t" << whole.mean << "\t" << whole.p99 << "\t" << whole.max << std::endl;
+    std::cout << "dirty regions\t" << frame.mean << "\t" << frame.p99 << "\t" << frame.max << std::endl;
+    std::cout << "Speedup (mean): " << whole.mean / juce::jmax(frame.mean, 1.0e-9) << "x" << std::endl;
+    return 0;
+}
+
+} // namespace RenderModes
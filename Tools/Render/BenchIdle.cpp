@@ -0,0 +1,112 @@
+#include "RenderModes.h"
+#include <iostream>
+#include <vector>
+
+namespace RenderModes {
+
+// --- Idle benchmark: the silence between kicks with and without the idle bypass ---
+// A kick at 0 and another --length seconds later. The stretch from where the bypassed render goes
+// exactly silent up to the second kick is timed with the bypass off and on (best of three), and the
+// second kick has to come out the same either way: the bypass resumes where the chain stopped.
+
+namespace {
+
+struct TwoKickRender {
+    std::vector<double> blockSeconds;
+    juce::AudioBuffer<float> output;
+};
+
+TwoKickRender renderTwoKicks(NextGenKickAudioProcessor& proc, const Settings& settings, int secondKick) {
+    const int totalSamples = secondKick + (int)(0.5 * settings.sampleRate);
+    TwoKickRender r;
+    r.output.setSize(2, totalSamples);
+    proc.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    juce::AudioBuffer<float> block(2, settings.blockSize);
+    juce::MidiBuffer midi;
+    for (int pos = 0; pos < totalSamples; pos += settings.blockSize) {
+        const int n = juce::jmin(settings.blockSize, totalSamples - pos);
+        block.setSize(2, n, false, false, true);
+        block.clear();
+        midi.clear();
+        for (int kick : { 0, secondKick })
+            if (kick >= pos && kick < pos + n) midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), kick - pos);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        proc.processBlock(block, midi);
+        r.blockSeconds.push_back(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+        for (int ch = 0; ch < 2; ++ch) r.output.copyFrom(ch, pos, block, ch, 0, n);
+    }
+    return r;
+}
+
+} // namespace
+
+int benchIdle(const Settings& settings, const juce::String& presetList) {
+    static constexpr int repeats = 3;
+    static constexpr float matchBound = 1.0e-6f;
+
+    NextGenKickAudioProcessor proc;
+    setUpOffline(proc, settings.sampleRate, settings.blockSize);
+    const auto presets = parseIndexList(presetList, 0, (int)proc.presetList.size() - 1);
+    const int secondKick = (int)(settings.lengthSeconds * settings.sampleRate) / settings.blockSize * settings.blockSize;
+    bool ok = true;
+
+    std::cout << "preset\tsilent after s\tkick ns/smp\tidle ns/smp (no bypass)\tidle ns/smp (bypass)\tspeedup\tsecond kick max diff" << std::endl;
+    for (int p : presets) {
+        proc.loadPreset(p);
+
+        TwoKickRender chain, bypassed;
+        std::vector<double> chainBest, bypassBest;
+        for (int r = 0; r < repeats; ++r) {
+            proc.useIdleBypass = false;
+            chain = renderTwoKicks(proc, settings, secondKick);
+            proc.useIdleBypass = true;
+            bypassed = renderTwoKicks(proc, settings, secondKick);
+            auto keepBest = [](std::vector<double>& best, const std::vector<double>& run) {
+                if (best.empty()) best = run;
+                for (size_t b = 0; b < best.size(); ++b) best[b] = juce::jmin(best[b], run[b]);
+            };
+            keepBest(chainBest, chain.blockSeconds);
+            keepBest(bypassBest, bypassed.blockSeconds);
+        }
+
+        // First block after which the bypassed render stays exactly zero until the second kick
+        const int kickBlock = secondKick / settings.blockSize;
+        int silentBlock = kickBlock;
+        while (silentBlock > 0) {
+            const int start = (silentBlock - 1) * settings.blockSize;
+            bool zero = true;
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = start; i < start + settings.blockSize; ++i) zero &= bypassed.output.getSample(ch, i) == 0.0f;
+            if (!zero) break;
+            --silentBlock;
+        }
+
+        auto nsPerSample = [&](const std::vector<double>& blocks, int first, int last) {
+            double seconds = 0.0;
+            for (int b = first; b < last; ++b) seconds += blocks[(size_t)b];
+            return last > first ? seconds * 1.0e9 / ((double)(last - first) * settings.blockSize) : 0.0;
+        };
+        const int firstIdle = juce::jmin(silentBlock + 1, kickBlock); // the block that flushed may still be partly loud
+        const double kickNs = nsPerSample(chainBest, 0, juce::jmin(kickBlock, (int)(0.5 * settings.sampleRate) / settings.blockSize + 1));
+        const double chainNs = nsPerSample(chainBest, firstIdle, kickBlock);
+        const double bypassNs = nsPerSample(bypassBest, firstIdle, kickBlock);
+
+        float maxDiff = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = secondKick; i < chain.output.getNumSamples(); ++i)
+                maxDiff = juce::jmax(maxDiff, std::abs(chain.output.getSample(ch, i) - bypassed.output.getSample(ch, i)));
+
+        std::cout << p << "\t" << (double)silentBlock * settings.blockSize / settings.sampleRate << "\t" << kickNs << "\t";
+        if (firstIdle < kickBlock) std::cout << chainNs << "\t" << bypassNs << "\t" << chainNs / juce::jmax(bypassNs, 1.0e-9) << "x\t";
+        else std::cout << "-\t-\t- (never idle; raise --length)\t";
+        std::cout << maxDiff << std::endl;
+        ok &= maxDiff <= matchBound;
+    }
+
+    std::cout << "second kick bound " << matchBound << "\n" << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,43 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Kernel benchmark: specialized vs. generic render/saturation path per combination ---
+int benchKernels(const Settings& settings) {
+    static constexpr int numAtkWaves = 8, numBodyWaves = 5, numSatTypes = 11, repeats = 3;
+
+    NextGenKickAudioProcessor proc;
+    setUpOffline(proc, settings.sampleRate, settings.blockSize, 0);
+    setParameter(proc, pMasterDrive, 4.0f); // drive > 1 so the saturation stage does real work
+
+    juce::AudioBuffer<float> block(2, settings.blockSize);
+    juce::MidiBuffer midi;
+    double sumGeneric = 0.0, sumSpecialized = 0.0;
+
+    std::cout << "atkWave\tbodyWave\tsatType\tgeneric ns/smp\tspecialized ns/smp\tspeedup" << std::endl;
+    for (int a = 0; a < numAtkWaves; ++a)
+        for (int b = 0; b < numBodyWaves; ++b)
+            for (int s = 0; s < numSatTypes; ++s) {
+                setParameter(proc, pAtkWave, (float)a);
+                setParameter(proc, pBodyWave, (float)b);
+                setParameter(proc, pSatType, (float)s);
+
+                // Best of N, alternating paths so both see the same cache/thermal conditions
+                double generic = 1.0e30, specialized = 1.0e30;
+                for (int r = 0; r < repeats; ++r) {
+                    proc.useSpecializedKernels = false;
+                    generic = juce::jmin(generic, timeOneShot(proc, settings, block, midi));
+                    proc.useSpecializedKernels = true;
+                    specialized = juce::jmin(specialized, timeOneShot(proc, settings, block, midi));
+                }
+                sumGeneric += generic; sumSpecialized += specialized;
+                std::cout << a << "\t" << b << "\t" << s << "\t" << generic << "\t" << specialized << "\t" << generic / specialized << "x" << std::endl;
+            }
+
+    std::cout << "Overall speedup: " << sumGeneric / sumSpecialized << "x" << std::endl;
+    return 0;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,124 @@
+#include "RenderModes.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace RenderModes {
+
+// --- Limiter detector benchmark: rescanning cached peak vs. sliding max vs. true peak ---
+
+namespace {
+
+static constexpr int limiterRingSize = 16384;
+static constexpr int limiterRingMask = limiterRingSize - 1;
+
+// The detector the limiter used before the monotonic deque, kept as the baseline
+void detectRescan(const std::vector<float>& inL, const std::vector<float>& inR, int lookahead, std::vector<float>& peaks) {
+    std::vector<float> ringL(limiterRingSize, 0.0f), ringR(limiterRingSize, 0.0f);
+    float cachedPeak = 0.0f;
+    int cachedPeakIdx = -1;
+
+    for (size_t n = 0; n < inL.size(); ++n) {
+        const int w = (int)n & limiterRingMask;
+        ringL[(size_t)w] = inL[n]; ringR[(size_t)w] = inR[n];
+        const float currentAbs = std::max(std::abs(inL[n]), std::abs(inR[n]));
+        const int tail = (w - lookahead + limiterRingSize) & limiterRingMask;
+
+        if (currentAbs >= cachedPeak) { cachedPeak = currentAbs; cachedPeakIdx = w; }
+        else if (cachedPeakIdx == tail) {
+            cachedPeak = 0.0f;
+            for (int k = 0; k < lookahead; ++k) {
+                const int idx = (w - k + limiterRingSize) & limiterRingMask;
+                const float p = std::max({ cachedPeak, std::abs(ringL[(size_t)idx]), std::abs(ringR[(size_t)idx]) });
+                if (p > cachedPeak) { cachedPeak = p; cachedPeakIdx = idx; }
+            }
+        }
+        peaks[n] = cachedPeak;
+    }
+}
+
+void detectSlidingMax(const std::vector<float>& inL, const std::vector<float>& inR, int lookahead, std::vector<float>& peaks) {
+    SlidingMaxWindow window;
+    window.prepare(limiterRingSize - 1);
+    for (size_t n = 0; n < inL.size(); ++n)
+        peaks[n] = window.push(std::max(std::abs(inL[n]), std::abs(inR[n])), lookahead + 1);
+}
+
+void detectTruePeak(const std::vector<float>& inL, const std::vector<float>& inR, int lookahead, std::vector<float>& peaks) {
+    std::vector<float> ringL(limiterRingSize, 0.0f), ringR(limiterRingSize, 0.0f);
+    SlidingMaxWindow window;
+    window.prepare(limiterRingSize - 1);
+    const TruePeakInterpolator truePeak;
+
+    for (size_t n = 0; n < inL.size(); ++n) {
+        const int w = (int)n & limiterRingMask;
+        ringL[(size_t)w] = inL[n]; ringR[(size_t)w] = inR[n];
+        const float tpL = truePeak.process([&ringL, w](int k) { return ringL[(size_t)((w - k) & limiterRingMask)]; });
+        const float tpR = truePeak.process([&ringR, w](int k) { return ringR[(size_t)((w - k) & limiterRingMask)]; });
+        peaks[n] = window.push(std::max(tpL, tpR), lookahead + 1);
+    }
+}
+
+template <typename Detector>
+double timeDetector(Detector detect, const std::vector<float>& inL, const std::vector<float>& inR, int lookahead, std::vector<float>& peaks) {
+    double best = 1.0e30;
+    for (int r = 0; r < 5; ++r) {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        detect(inL, inR, lookahead, peaks);
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        best = juce::jmin(best, seconds * 1.0e9 / (double)inL.size());
+    }
+    return best;
+}
+
+} // namespace
+
+int benchLimiter(double sampleRate) {
+    // Four decaying kicks (pitch sweep into a long tail), the case that made the old detector rescan
+    const int length = (int)(2.0 * sampleRate);
+    std::vector<float> inL((size_t)length), inR((size_t)length);
+    double phase = 0.0;
+    for (int n = 0; n < length; ++n) {
+        const double t = std::fmod((double)n / sampleRate, 0.5);
+        if (t * sampleRate < 1.0) phase = 0.0;
+        phase += juce::MathConstants<double>::twoPi * (50.0 + 200.0 * std::exp(-t / 0.03)) / sampleRate;
+        const float x = (float)(std::sin(phase) * std::exp(-t / 0.4));
+        inL[(size_t)n] = x; inR[(size_t)n] = 0.9f * x;
+    }
+
+    bool ok = true;
+    std::vector<float> peaksRescan((size_t)length), peaksSliding((size_t)length), peaksTrue((size_t)length);
+    std::cout << "lookahead ms\trescan ns/smp\tsliding max ns/smp\ttrue peak ns/smp\tsliding max errors\ttrue peak errors\tmax inter-sample over (dB)" << std::endl;
+    for (double ms : { 1.0, 5.0, 20.0 }) {
+        const int lookahead = (int)(ms * 0.001 * sampleRate);
+        const double tRescan = timeDetector(detectRescan, inL, inR, lookahead, peaksRescan);
+        const double tSliding = timeDetector(detectSlidingMax, inL, inR, lookahead, peaksSliding);
+        const double tTrue = timeDetector(detectTruePeak, inL, inR, lookahead, peaksTrue);
+
+        // The deque must match a brute-force maximum over the same lookahead + 1 samples exactly;
+        // the true peak (lagging by its delay) must never read below the samples it covers
+        auto samplePeak = [&](int from, int to) {
+            float p = 0.0f;
+            for (int k = juce::jmax(0, from); k <= to; ++k) p = std::max({ p, std::abs(inL[(size_t)k]), std::abs(inR[(size_t)k]) });
+            return p;
+        };
+        int slidingErrors = 0, trueErrors = 0;
+        float maxOver = 1.0f;
+        for (int n = 0; n < length; ++n) {
+            if (peaksSliding[(size_t)n] != samplePeak(n - lookahead, n)) ++slidingErrors;
+            const float covered = samplePeak(n - lookahead - TruePeakInterpolator::delay - 1, n - TruePeakInterpolator::delay);
+            if (peaksTrue[(size_t)n] < covered) ++trueErrors;
+            else if (covered > 0.0f) maxOver = std::max(maxOver, peaksTrue[(size_t)n] / covered);
+        }
+        ok &= slidingErrors == 0 && trueErrors == 0;
+
+        std::cout << ms << "\t" << tRescan << "\t" << tSliding << "\t" << tTrue << "\t" << slidingErrors << "\t" << trueErrors << "\t"
+            << juce::Decibels::gainToDecibels(maxOver) << std::endl;
+    }
+
+    std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
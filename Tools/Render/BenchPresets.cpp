@@ -0,0 +1,68 @@
+#include "RenderModes.h"
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Preset switch benchmark: value-by-value vs. batched parameter changes ---
+// Steps through the presets as someone scrolling the list would, then randomizes as often, timing
+// every change on the calling (message) thread and counting what a host hears of it: value
+// notifications and gestures. Best of --passes per mode.
+
+namespace {
+
+struct HostNotificationCounter : juce::AudioProcessorListener {
+    int values = 0, gestures = 0;
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override { ++values; }
+    void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override {}
+    void audioProcessorParameterChangeGestureBegin(juce::AudioProcessor*, int) override { ++gestures; }
+};
+
+} // namespace
+
+int benchPresets(const juce::String& presetList, int passes) {
+    NextGenKickAudioProcessor proc;
+    setUpOffline(proc, 48000.0, 512);
+    HostNotificationCounter counter;
+    proc.addListener(&counter);
+    const auto presets = parseIndexList(presetList, 0, (int)proc.presetList.size() - 1);
+    if (presets.empty()) return 1;
+
+    struct Result { double meanUs = 1.0e30, maxUs = 1.0e30; double values = 0.0, gestures = 0.0; };
+    auto timeSwitches = [&](bool batched, bool randomize) {
+        proc.useBatchedParameterChanges = batched;
+        Result best;
+        for (int pass = 0; pass < passes; ++pass) {
+            proc.loadPreset(presets.back()); // every pass starts from the same state
+            counter.values = counter.gestures = 0;
+            double total = 0.0, worst = 0.0;
+            for (int p : presets) {
+                const auto start = juce::Time::getHighResolutionTicks();
+                if (randomize) proc.performRandomization();
+                else proc.loadPreset(p);
+                const double us = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+                total += us;
+                worst = juce::jmax(worst, us);
+            }
+            best.meanUs = juce::jmin(best.meanUs, total / (double)presets.size());
+            best.maxUs = juce::jmin(best.maxUs, worst);
+            best.values = (double)counter.values / (double)presets.size();
+            best.gestures = (double)counter.gestures / (double)presets.size();
+        }
+        return best;
+    };
+
+    std::cout << "action\tmode\tmean us/change\tmax us/change\tnotifications/change\tgestures/change" << std::endl;
+    for (bool randomize : { false, true }) {
+        const Result before = timeSwitches(false, randomize);
+        const Result after = timeSwitches(true, randomize);
+        const char* action = randomize ? "randomize" : "load preset";
+        std::cout << action << "\tvalue by value\t" << before.meanUs << "\t" << before.maxUs << "\t" << before.values << "\t" << before.gestures << std::endl;
+        std::cout << action << "\tbatched\t" << after.meanUs << "\t" << after.maxUs << "\t" << after.values << "\t" << after.gestures << std::endl;
+        std::cout << action << " speedup: " << before.meanUs / juce::jmax(after.meanUs, 1.0e-9) << "x" << std::endl;
+    }
+
+    proc.removeListener(&counter);
+    return 0;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,53 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Stem cache benchmark: one-shot cost with every layer live vs. played from cached stems ---
+// A first note queues the stems and the render thread fills them in; the cached run then has to
+// match the live one to float rounding. Noise attacks are never cached and differ between runs.
+int benchStemCache(const Settings& settings, const juce::String& presetList) {
+    static constexpr int repeats = 3;
+
+    NextGenKickAudioProcessor proc;
+    setUpOffline(proc, settings.sampleRate, settings.blockSize);
+    const auto presets = parseIndexList(presetList, 0, (int)proc.presetList.size() - 1);
+    const int totalSamples = (int)std::ceil(settings.lengthSeconds * settings.sampleRate);
+
+    juce::AudioBuffer<float> block(2, settings.blockSize), live(2, totalSamples), cached(2, totalSamples);
+    juce::MidiBuffer midi;
+    double sumLive = 0.0, sumCached = 0.0;
+
+    std::cout << "preset\tlive ns/smp\tcached ns/smp\tspeedup\tmax diff" << std::endl;
+    for (int p : presets) {
+        proc.loadPreset(p);
+
+        proc.useStemCache = true;
+        timeOneShot(proc, settings, block, midi);
+        juce::Thread::sleep(250);
+
+        double liveNs = 1.0e30, cachedNs = 1.0e30;
+        for (int r = 0; r < repeats; ++r) {
+            proc.useStemCache = false;
+            liveNs = juce::jmin(liveNs, timeOneShot(proc, settings, block, midi, &live));
+            proc.useStemCache = true;
+            cachedNs = juce::jmin(cachedNs, timeOneShot(proc, settings, block, midi, &cached));
+        }
+        sumLive += liveNs; sumCached += cachedNs;
+
+        std::cout << p << "\t" << liveNs << "\t" << cachedNs << "\t" << liveNs / cachedNs << "x\t";
+        if (proc.presetList[(size_t)p][pAtkWave] < 3.0f) { std::cout << "n/a (noise attack)" << std::endl; continue; }
+
+        float maxDiff = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < totalSamples; ++i)
+                maxDiff = juce::jmax(maxDiff, std::abs(live.getSample(ch, i) - cached.getSample(ch, i)));
+        std::cout << maxDiff << std::endl;
+    }
+
+    std::cout << "Overall speedup: " << sumLive / sumCached << "x" << std::endl;
+    return 0;
+}
+
+} // namespace RenderModes
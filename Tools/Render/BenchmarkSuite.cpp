@@ -0,0 +1,450 @@
+#include "BenchmarkSuite.h"
+#include "RenderHarness.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace BenchmarkSuite {
+
+TimingStats TimingStats::of(std::vector<double> values) {
+    TimingStats s;
+    if (values.empty()) return s;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    s.mean = sum / (double)values.size();
+    auto quantile = [&values](double q) { return values[std::min(values.size() - 1, (size_t)(q * (double)values.size()))]; };
+    s.p99 = quantile(0.99);
+    s.p999 = quantile(0.999);
+    s.max = values.back();
+    return s;
+}
+
+namespace {
+
+using RenderHarness::setParameter;
+
+double microsecondsSince(juce::int64 startTicks) {
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6;
+}
+
+juce::DynamicObject* makeRecord(double nsPerSample, const TimingStats& blocks) {
+    auto* record = new juce::DynamicObject();
+    record->setProperty("nsPerSample", nsPerSample);
+    record->setProperty("meanUs", blocks.mean);
+    record->setProperty("p99Us", blocks.p99);
+    record->setProperty("p999Us", blocks.p999);
+    record->setProperty("maxUs", blocks.max);
+    return record;
+}
+
+// --- processBlock: one preset x osMode x satType x block size ---
+// Each pass plays a note at every position in `notes` (ascending), after an untimed warm-up pass
+juce::var benchCase(NextGenKickAudioProcessor& proc, const Options& options, double lengthSeconds, int blockSize, const std::vector<int>& notes,
+    juce::AudioBuffer<float>& block, juce::MidiBuffer& midi) {
+    const int totalSamples = (int)std::ceil(lengthSeconds * options.sampleRate);
+    std::vector<double> blockUs, noteOnUs;
+    double totalUs = 0.0;
+
+    for (int pass = 0; pass <= options.passes; ++pass) {
+        proc.prepareToPlay(options.sampleRate, blockSize);
+        size_t nextNote = 0;
+        for (int pos = 0; pos < totalSamples; pos += blockSize) {
+            const int n = juce::jmin(blockSize, totalSamples - pos);
+            block.setSize(2, n, false, false, true);
+            block.clear();
+            midi.clear();
+            const bool noteOn = nextNote < notes.size() && notes[nextNote] < pos + n;
+            for (; nextNote < notes.size() && notes[nextNote] < pos + n; ++nextNote)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), notes[nextNote] - pos);
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            proc.processBlock(block, midi);
+            const double us = microsecondsSince(startTicks);
+
+            if (pass == 0) continue;
+            blockUs.push_back(us);
+            if (noteOn) noteOnUs.push_back(us);
+            totalUs += us;
+        }
+    }
+
+    const double nsPerSample = totalUs * 1000.0 / ((double)totalSamples * (double)options.passes);
+    auto* record = makeRecord(nsPerSample, TimingStats::of(blockUs));
+    record->setProperty("noteOnMaxUs", TimingStats::of(noteOnUs).max);
+    return juce::var(record);
+}
+
+// A note at the start and another halfway: the shape every processBlock case plays
+std::vector<int> twoNotes(int totalSamples) { return { 0, totalSamples / 2 }; }
+
+// A note every `spacing` samples from the start
+std::vector<int> noteRoll(int totalSamples, int spacing) {
+    std::vector<int> notes;
+    for (int pos = 0; pos < totalSamples; pos += spacing) notes.push_back(pos);
+    return notes;
+}
+
+// --- Event density: two notes vs. 16th and 32nd rolls at 120 BPM, per block size 1..8192 ---
+// processBlock splits the block at every note-on, so the cost has to follow the number of notes and
+// not the host block size: the roll's ns/sample should stay level across block sizes, and so should
+// the cost of each note the 32nd roll adds over the two-note case.
+juce::Array<juce::var> benchEventDensity(NextGenKickAudioProcessor& proc, const Options& options, int preset,
+    juce::AudioBuffer<float>& block, juce::MidiBuffer& midi) {
+    static constexpr double bpm = 120.0;
+    const double lengthSeconds = std::max(1.0, options.lengthSeconds); // 16 notes of the 32nd roll at least
+    const int totalSamples = (int)std::ceil(lengthSeconds * options.sampleRate);
+    const int sixteenth = (int)std::round(options.sampleRate * 60.0 / bpm / 4.0);
+    const auto sparse = twoNotes(totalSamples), sixteenths = noteRoll(totalSamples, sixteenth), thirtySeconds = noteRoll(totalSamples, sixteenth / 2);
+
+    juce::Array<juce::var> results;
+    double minRoll = 1.0e30, maxRoll = 0.0, minPerNote = 1.0e30, maxPerNote = 0.0;
+
+    std::cout << "\nevent density, preset " << preset << ": " << sparse.size() << " / " << sixteenths.size() << " / " << thirtySeconds.size()
+        << " notes in " << lengthSeconds << " s" << std::endl;
+    std::cout << "block\tns/smp (2 notes)\tns/smp (16ths)\tns/smp (32nds)\tus per added note\t32nds p99 us\t32nds max us" << std::endl;
+    for (int blockSize = 1; blockSize <= 8192; blockSize *= 2) {
+        RenderHarness::setUpOffline(proc, options.sampleRate, blockSize, preset);
+        const double sparseNs = (double)benchCase(proc, options, lengthSeconds, blockSize, sparse, block, midi)["nsPerSample"];
+        const double sixteenthsNs = (double)benchCase(proc, options, lengthSeconds, blockSize, sixteenths, block, midi)["nsPerSample"];
+        auto roll = benchCase(proc, options, lengthSeconds, blockSize, thirtySeconds, block, midi);
+        const double rollNs = (double)roll["nsPerSample"];
+        const double usPerNote = (rollNs - sparseNs) * (double)totalSamples / 1000.0 / (double)(thirtySeconds.size() - sparse.size());
+
+        if (auto* record = roll.getDynamicObject()) {
+            record->setProperty("name", "32nd roll/block " + juce::String(blockSize));
+            record->setProperty("preset", preset);
+            record->setProperty("block", blockSize);
+            record->setProperty("notes", (int)thirtySeconds.size());
+            record->setProperty("twoNoteNsPerSample", sparseNs);
+            record->setProperty("sixteenthsNsPerSample", sixteenthsNs);
+            record->setProperty("usPerAddedNote", usPerNote);
+        }
+        std::cout << blockSize << "\t" << sparseNs << "\t" << sixteenthsNs << "\t" << rollNs << "\t" << usPerNote << "\t"
+            << (double)roll["p99Us"] << "\t" << (double)roll["maxUs"] << std::endl;
+        results.add(roll);
+
+        minRoll = std::min(minRoll, rollNs); maxRoll = std::max(maxRoll, rollNs);
+        minPerNote = std::min(minPerNote, usPerNote); maxPerNote = std::max(maxPerNote, usPerNote);
+    }
+
+    std::cout << "32nd roll across block sizes: " << minRoll << " .. " << maxRoll << " ns/smp (" << maxRoll / std::max(minRoll, 1.0e-9)
+        << "x), " << minPerNote << " .. " << maxPerNote << " us per added note" << std::endl;
+    return results;
+}
+
+// --- Isolated kernels: one internal chunk per call, fed a decaying sine sweep ---
+juce::var benchKernel(NextGenKickAudioProcessor::KernelBenchmark& kernel, const Options& options, const std::vector<float>& input) {
+    static constexpr int chunk = 64;
+    const int totalSamples = (int)std::ceil(options.lengthSeconds * options.sampleRate);
+    std::vector<float> out((size_t)chunk);
+    std::vector<double> chunkUs;
+    double totalUs = 0.0;
+
+    for (int pass = 0; pass <= options.passes; ++pass)
+        for (int pos = 0; pos < totalSamples; pos += chunk) {
+            const int n = juce::jmin(chunk, totalSamples - pos);
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            kernel.process(input.data() + (size_t)(pos % ((int)input.size() - chunk)), out.data(), n);
+            const double us = microsecondsSince(startTicks);
+            if (pass == 0) continue;
+            chunkUs.push_back(us);
+            totalUs += us;
+        }
+
+    const double nsPerSample = totalUs * 1000.0 / ((double)totalSamples * (double)options.passes);
+    auto* record = makeRecord(nsPerSample, TimingStats::of(chunkUs));
+    record->setProperty("name", kernel.name);
+    return juce::var(record);
+}
+
+// --- Parameter smoothing: the voice loop's span-smoothed parameters, 64 samples per call ---
+// The baseline is the loop before SmoothedBlockParam: one LinearSmoothedValue per parameter stepped
+// every sample, the sub note's frequency through pow() and the anti-click fade's division every
+// sample. Settled, one parameter ramping (retargeted every 0.1 s) and all of them ramping. Both
+// sides read the same values in the same order, so their per-sample sums have to match exactly.
+static constexpr int numSpanParams = countParams(ParamSmoothing::Span);
+
+std::array<ParamId, numSpanParams> spanParams() {
+    std::array<ParamId, numSpanParams> ids{};
+    size_t k = 0;
+    for (int p = 0; p < numParams; ++p)
+        if (paramSpec((ParamId)p).smoothing == ParamSmoothing::Span) ids[k++] = (ParamId)p;
+    return ids;
+}
+
+int spanIndex(ParamId id) {
+    const auto ids = spanParams();
+    return (int)(std::find(ids.begin(), ids.end(), id) - ids.begin());
+}
+
+// Every `period` samples, the first numMoving parameters swap between their default and a point a
+// quarter of the range away
+struct SmoothingSchedule {
+    int numMoving = 0, period = 1;
+
+    template <typename Fn>
+    void retarget(int pos, Fn&& setTarget) const {
+        if (numMoving == 0 || pos % period != 0) return;
+        const bool away = (pos / period) % 2 == 1;
+        const auto ids = spanParams();
+        for (int k = 0; k < numMoving; ++k) {
+            const auto& spec = paramSpec(ids[(size_t)k]);
+            const float other = spec.def + (spec.def > 0.5f * (spec.min + spec.max) ? -0.25f : 0.25f) * (spec.max - spec.min);
+            setTarget(k, away ? other : spec.def);
+        }
+    }
+};
+
+double subNoteHz(float note) { return 440.0 * std::pow(2.0, ((double)note - 69.0) / 12.0); }
+
+// The voice loop's parameter reads before SmoothedBlockParam, kept as the baseline
+struct PerSampleSmoothing {
+    PerSampleSmoothing(double sampleRate, SmoothingSchedule s) : rate(sampleRate), schedule(s) {
+        const auto ids = spanParams();
+        for (size_t k = 0; k < values.size(); ++k) {
+            values[k].reset(sampleRate, paramSpec(ids[k]).smoothingSeconds);
+            values[k].setCurrentAndTargetValue(paramSpec(ids[k]).def);
+        }
+    }
+
+    void process(float* out, int numSamples) {
+        schedule.retarget(pos, [this](int k, float v) { values[(size_t)k].setTargetValue(v); });
+        std::array<float, numSpanParams> v;
+        for (int i = 0; i < numSamples; ++i) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < values.size(); ++k) { v[k] = values[k].getNextValue(); sum += v[k]; }
+            const double sFixedHz = subNoteHz(v[(size_t)subNote]);
+            const float subFadeInv = 1.0f / ((v[(size_t)antiClick] / 1000.0f) * (float)rate + 0.001f);
+            derived += sFixedHz + (double)subFadeInv;
+            out[i] = sum;
+        }
+        pos += numSamples;
+    }
+
+    std::array<juce::LinearSmoothedValue<float>, numSpanParams> values;
+    double rate;
+    SmoothingSchedule schedule;
+    int pos = 0, subNote = spanIndex(pSubNote), antiClick = spanIndex(pSubAntiClick);
+    double derived = 0.0;
+};
+
+// The same reads through SmoothedBlockParam, as renderVoices and renderSpan make them
+struct SpanSmoothing {
+    SpanSmoothing(double sampleRate, SmoothingSchedule s) : rate(sampleRate), schedule(s) {
+        const auto ids = spanParams();
+        for (size_t k = 0; k < params.size(); ++k) {
+            params[k].setTargetValue(paramSpec(ids[k]).def); // target first: prepare snaps to it, as prepareToPlay does
+            params[k].prepare(sampleRate, paramSpec(ids[k]).smoothingSeconds, 64);
+        }
+    }
+
+    void process(float* out, int numSamples) {
+        schedule.retarget(pos, [this](int k, float v) { params[(size_t)k].setTargetValue(v); });
+        for (auto& p : params) p.process(numSamples);
+        const auto& note = params[(size_t)subNote];
+        const double sFixedHzStatic = subNoteHz(note[0]);
+        for (int i = 0; i < numSamples; ++i) {
+            float sum = 0.0f;
+            for (const auto& p : params) sum += p[i];
+            const double sFixedHz = note.isRamping() ? subNoteHz(note[i]) : sFixedHzStatic;
+            fade.setParameters(params[(size_t)antiClick][i], rate);
+            derived += sFixedHz;
+            out[i] = sum;
+        }
+        pos += numSamples;
+    }
+
+    std::array<SmoothedBlockParam, numSpanParams> params;
+    RaisedCosineFade fade;
+    double rate;
+    SmoothingSchedule schedule;
+    int pos = 0, subNote = spanIndex(pSubNote), antiClick = spanIndex(pSubAntiClick);
+    double derived = 0.0;
+};
+
+// Per-sample and span kernels for every case; `matches` is cleared if any case reads different values
+std::vector<NextGenKickAudioProcessor::KernelBenchmark> makeSmoothingBenchmarks(double sampleRate, bool& matches) {
+    static constexpr int chunk = 64;
+    const int period = juce::jmax(1, (int)std::round(0.1 * sampleRate / chunk)) * chunk;
+    const std::pair<const char*, int> cases[] = { { "settled", 0 }, { "1 ramping", 1 }, { "all ramping", numSpanParams } };
+
+    std::vector<NextGenKickAudioProcessor::KernelBenchmark> kernels;
+    for (const auto& c : cases) {
+        const SmoothingSchedule schedule{ c.second, period };
+
+        PerSampleSmoothing before(sampleRate, schedule);
+        SpanSmoothing after(sampleRate, schedule);
+        std::vector<float> a((size_t)chunk), b((size_t)chunk);
+        for (int pos = 0; pos < 4 * period; pos += chunk) {
+            before.process(a.data(), chunk);
+            after.process(b.data(), chunk);
+            matches &= a == b;
+        }
+
+        auto perSample = std::make_shared<PerSampleSmoothing>(sampleRate, schedule);
+        auto spans = std::make_shared<SpanSmoothing>(sampleRate, schedule);
+        kernels.push_back({ juce::String("smoothing/") + c.first + " (per sample)", [perSample](const float*, float* out, int n) { perSample->process(out, n); } });
+        kernels.push_back({ juce::String("smoothing/") + c.first + " (spans)", [spans](const float*, float* out, int n) { spans->process(out, n); } });
+    }
+    return kernels;
+}
+
+juce::String caseKey(const juce::var& record) {
+    if (record.hasProperty("name")) return record["name"].toString();
+    return "preset " + record["preset"].toString() + " osMode " + record["osMode"].toString()
+        + " satType " + record["satType"].toString() + " block " + record["block"].toString();
+}
+
+} // namespace
+
+int run(const Options& options) {
+    NextGenKickAudioProcessor proc;
+
+    juce::Array<juce::var> blockResults, densityResults, kernelResults;
+    std::cout << "SIMD: " << LayerOscillatorCore::instructionSet() << " (" << LayerOscillatorCore::vecSize << " floats per register)\n" << std::endl;
+
+    if (!options.kernelsOnly) {
+        const int maxBlock = options.blockSizes.empty() ? 1 : *std::max_element(options.blockSizes.begin(), options.blockSizes.end());
+        juce::AudioBuffer<float> block(2, maxBlock);
+        juce::MidiBuffer midi;
+
+        std::cout << "preset\tosMode\tsatType\tblock\tns/smp\tmean us\tp99 us\tp999 us\tmax us\tnote-on max us" << std::endl;
+        for (int p : options.presets)
+            for (int os : options.osModes)
+                for (int sat : options.satTypes)
+                    for (int blockSize : options.blockSizes) {
+                        RenderHarness::setUpOffline(proc, options.sampleRate, blockSize, p);
+                        setParameter(proc, pOsMode, (float)os);
+                        setParameter(proc, pSatType, (float)sat);
+
+                        auto result = benchCase(proc, options, options.lengthSeconds, blockSize,
+                            twoNotes((int)std::ceil(options.lengthSeconds * options.sampleRate)), block, midi);
+                        if (auto* record = result.getDynamicObject()) {
+                            record->setProperty("preset", p);
+                            record->setProperty("osMode", os);
+                            record->setProperty("satType", sat);
+                            record->setProperty("block", blockSize);
+                        }
+                        std::cout << p << "\t" << os << "\t" << sat << "\t" << blockSize << "\t" << (double)result["nsPerSample"] << "\t"
+                            << (double)result["meanUs"] << "\t" << (double)result["p99Us"] << "\t" << (double)result["p999Us"] << "\t"
+                            << (double)result["maxUs"] << "\t" << (double)result["noteOnMaxUs"] << std::endl;
+                        blockResults.add(result);
+                    }
+
+        if (!options.presets.empty()) {
+            block.setSize(2, 8192);
+            densityResults = benchEventDensity(proc, options, options.presets.front(), block, midi);
+        }
+        std::cout << std::endl;
+    }
+
+    // Two kicks a second: a sweep from 400 Hz down into a 50 Hz tail, decaying over 0.2 s
+    std::vector<float> input((size_t)std::max(1024, (int)options.sampleRate));
+    double phase = 0.0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        const double t = std::fmod((double)i / options.sampleRate, 0.5);
+        phase += juce::MathConstants<double>::twoPi * (50.0 + 350.0 * std::exp(-t / 0.03)) / options.sampleRate;
+        input[i] = (float)(0.9 * std::sin(phase) * std::exp(-t / 0.2));
+    }
+
+    bool smoothingMatches = true;
+    auto kernels = proc.makeKernelBenchmarks(options.sampleRate);
+    for (auto& kernel : makeSmoothingBenchmarks(options.sampleRate, smoothingMatches)) kernels.push_back(std::move(kernel));
+
+    std::cout << "kernel\tns/smp\tmean us\tp99 us\tp999 us\tmax us" << std::endl;
+    for (auto& kernel : kernels) {
+        auto result = benchKernel(kernel, options, input);
+        std::cout << kernel.name.toRawUTF8() << "\t" << (double)result["nsPerSample"] << "\t" << (double)result["meanUs"] << "\t"
+            << (double)result["p99Us"] << "\t" << (double)result["p999Us"] << "\t" << (double)result["maxUs"] << std::endl;
+        kernelResults.add(result);
+    }
+
+    // Oscillator core before/after: double-phase ns over SIMD-lane ns per voice count, for this build's instruction set
+    for (int k = 0; k + 1 < kernelResults.size(); ++k) {
+        const auto name = kernelResults[k]["name"].toString();
+        if (!name.startsWith("oscillatorCore/") || !kernelResults[k + 1]["name"].toString().endsWith(" (double phases, before)")) continue;
+        const double after = (double)kernelResults[k]["nsPerSample"], before = (double)kernelResults[k + 1]["nsPerSample"];
+        std::cout << name.toRawUTF8() << ": " << after << " ns/smp vs. " << before << " ns/smp with double phases, "
+            << before / juce::jmax(after, 1.0e-9) << "x faster" << std::endl;
+    }
+
+    // Smoothing before/after: per-sample ns over span ns for each case
+    for (int k = 0; k + 1 < kernelResults.size(); ++k) {
+        const auto name = kernelResults[k]["name"].toString();
+        if (!name.startsWith("smoothing/") || !name.endsWith(" (per sample)")) continue;
+        const double before = (double)kernelResults[k]["nsPerSample"], after = (double)kernelResults[k + 1]["nsPerSample"];
+        std::cout << name.upToLastOccurrenceOf(" (", false, false).toRawUTF8() << ": " << before / juce::jmax(after, 1.0e-9) << "x faster in spans" << std::endl;
+    }
+    std::cout << "smoothing: spans read " << (smoothingMatches ? "the same values as" : "DIFFERENT values from") << " per-sample smoothing" << std::endl;
+
+    if (options.jsonFile != juce::File()) {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("sampleRate", options.sampleRate);
+        root->setProperty("lengthSeconds", options.lengthSeconds);
+        root->setProperty("passes", options.passes);
+        root->setProperty("simd", LayerOscillatorCore::instructionSet());
+        root->setProperty("processBlock", blockResults);
+        root->setProperty("eventDensity", densityResults);
+        root->setProperty("kernels", kernelResults);
+        if (!options.jsonFile.replaceWithText(juce::JSON::toString(juce::var(root)))) {
+            std::cerr << "Cannot write " << options.jsonFile.getFullPathName().toRawUTF8() << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.jsonFile.getFullPathName().toRawUTF8() << std::endl;
+    }
+    return smoothingMatches ? 0 : 1;
+}
+
+int compare(const juce::File& baseline, const juce::File& current, double tolerancePercent) {
+    const auto base = juce::JSON::parse(baseline), now = juce::JSON::parse(current);
+    if (!base.isObject() || !now.isObject()) {
+        std::cerr << "Cannot read " << (base.isObject() ? current : baseline).getFullPathName().toRawUTF8() << std::endl;
+        return 1;
+    }
+
+    // Results from SSE2, AVX2 and NEON builds are compared like any others, but say so
+    if (base["simd"].toString() != now["simd"].toString())
+        std::cout << "SIMD: " << base["simd"].toString().toRawUTF8() << " (baseline) vs. " << now["simd"].toString().toRawUTF8() << " (current)\n" << std::endl;
+
+    const double limit = 1.0 + tolerancePercent / 100.0;
+    int numCompared = 0, numRegressed = 0;
+    double logRatioSum = 0.0;
+
+    std::cout << "case\tbaseline ns/smp\tcurrent ns/smp\tratio\tbaseline p99 us\tcurrent p99 us\tratio" << std::endl;
+    for (const char* section : { "processBlock", "eventDensity", "kernels" }) {
+        std::map<std::string, juce::var> baseCases;
+        if (auto* list = base[section].getArray())
+            for (const auto& record : *list) baseCases[caseKey(record).toStdString()] = record;
+
+        if (auto* list = now[section].getArray())
+            for (const auto& record : *list) {
+                const auto match = baseCases.find(caseKey(record).toStdString());
+                if (match == baseCases.end()) continue;
+
+                const double nsRatio = (double)record["nsPerSample"] / std::max(1.0e-9, (double)match->second["nsPerSample"]);
+                const double p99Ratio = (double)record["p99Us"] / std::max(1.0e-9, (double)match->second["p99Us"]);
+                ++numCompared;
+                logRatioSum += std::log(nsRatio);
+
+                if (nsRatio > limit || p99Ratio > limit) {
+                    ++numRegressed;
+                    std::cout << caseKey(record).toRawUTF8() << "\t" << (double)match->second["nsPerSample"] << "\t" << (double)record["nsPerSample"] << "\t"
+                        << nsRatio << "x\t" << (double)match->second["p99Us"] << "\t" << (double)record["p99Us"] << "\t" << p99Ratio << "x" << std::endl;
+                }
+            }
+    }
+
+    const double geoMean = numCompared > 0 ? std::exp(logRatioSum / numCompared) : 1.0;
+    std::cout << numCompared << " cases compared, " << numRegressed << " slower than +" << tolerancePercent << "%" << std::endl;
+    std::cout << "Overall ns/sample ratio (geometric mean): " << geoMean << "x" << std::endl;
+    std::cout << (numRegressed == 0 ? "PASS" : "FAIL") << std::endl;
+    return numRegressed == 0 ? 0 : 1;
+}
+
+} // namespace BenchmarkSuite
@@ -0,0 +1,32 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// --- DSP benchmark suite ---
+// processBlock in ns/sample for every preset x osMode x satType x block size, and the inner kernels
+// on their own. Every block is timed individually, so the results carry p99/p999 and the worst
+// note-on block as well as the mean. Note rolls across block sizes 1..8192 show what each note-on
+// costs. Results are written as JSON; compare() diffs two result files.
+namespace BenchmarkSuite {
+
+struct TimingStats {
+    double mean = 0.0, p99 = 0.0, p999 = 0.0, max = 0.0;
+    static TimingStats of(std::vector<double> values);
+};
+
+struct Options {
+    double sampleRate = 48000.0;
+    double lengthSeconds = 0.25; // per case and pass
+    int passes = 3;
+    std::vector<int> presets, osModes, satTypes, blockSizes;
+    bool kernelsOnly = false;
+    juce::File jsonFile;         // written if set
+};
+
+// Runs every case, prints one line per case and writes the JSON; returns the exit code
+int run(const Options& options);
+
+// Flags cases whose ns/sample or p99 block time grew by more than tolerancePercent; returns 1 if any did
+int compare(const juce::File& baseline, const juce::File& current, double tolerancePercent);
+
+} // namespace BenchmarkSuite
@@ -0,0 +1,58 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Envelope check: recursive generators vs. the closed forms they replace ---
+// Sweeps the parameter ranges of every envelope at common rates; fails when an error exceeds the
+// bound documented in EnvelopeGenerators.h.
+int checkEnvelopes() {
+    static constexpr double expTolerance = 1.0e-6, powTolerance = 2.0e-3, fadeTolerance = 1.0e-6;
+    double worstExp = 0.0, worstPow = 0.0, worstFade = 0.0;
+
+    for (double sr : { 44100.0, 48000.0, 96000.0, 192000.0 }) {
+        const int maxSamples = (int)(sr * 6.0);
+
+        for (float decay : { 0.01f, 0.07f, 0.35f, 1.5f, 5.0f })
+            for (float curve : { 0.1f, 1.0f, 4.0f, 10.0f }) {
+                ExpDecayEnvelope env; env.setParameters(decay, curve, sr);
+                double state; ExpDecayEnvelope::start(state);
+                for (int n = 0; n < maxSamples; ++n) {
+                    const double ref = std::pow(std::exp(-(n / sr) / ((double)decay + 0.0001)), (double)curve);
+                    worstExp = juce::jmax(worstExp, std::abs(ref - (double)env.tick(state)));
+                    if (ref < 1.0e-7) break;
+                }
+            }
+
+        for (float decay : { 0.001f, 0.002f, 0.005f, 0.01f, 0.05f, 0.2f })
+            for (float curve : { 0.1f, 0.2f, 0.3f, 0.5f, 0.7f, 1.0f, 1.5f, 2.0f, 3.0f, 5.0f, 10.0f }) {
+                PowerDecayEnvelope env; env.setParameters(decay, curve, sr);
+                PowerDecayEnvelope::State state; PowerDecayEnvelope::start(state);
+                for (int n = 0; n < (int)(sr * 0.25); ++n) {
+                    const double t = n / sr;
+                    const double ref = std::pow(juce::jmax(0.0, 1.0 - t / ((double)decay + 0.0001)), (double)curve);
+                    worstPow = juce::jmax(worstPow, std::abs(ref - (double)env.tick(state, t)));
+                }
+            }
+
+        for (float fadeMs : { 0.1f, 1.0f, 5.0f, 20.0f, 50.0f }) {
+            RaisedCosineFade fade; fade.setParameters(fadeMs, sr);
+            RaisedCosineFade::State state; RaisedCosineFade::start(state);
+            const float inv = 1.0f / ((fadeMs / 1000.0f) * (float)sr + 0.001f);
+            for (int n = 0; n < (int)(sr * 0.1); ++n) {
+                const double ref = (float)n * inv < 1.0f ? 0.5 * (1.0 - std::cos(juce::MathConstants<double>::pi * n * (double)inv)) : 1.0;
+                worstFade = juce::jmax(worstFade, std::abs(ref - (double)fade.tick(state)));
+            }
+        }
+    }
+
+    const bool ok = worstExp <= expTolerance && worstPow <= powTolerance && worstFade <= fadeTolerance;
+    std::cout << "Exp decay     max abs error " << worstExp << " (bound " << expTolerance << ")\n"
+        << "Power decay   max abs error " << worstPow << " (bound " << powTolerance << ")\n"
+        << "Anti-click    max abs error " << worstFade << " (bound " << fadeTolerance << ")\n"
+        << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
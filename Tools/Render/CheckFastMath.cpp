@@ -0,0 +1,75 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace RenderModes {
+
+// --- FastMath check: accuracy vs. double precision and speed vs. the std:: float calls ---
+
+namespace {
+
+// ns per call over a block of inputs; templated so the call inlines as it does in the kernels
+template <typename Fn>
+double timePerCall(Fn fn, const std::vector<float>& inputs, std::vector<float>& outputs) {
+    static constexpr int repeats = 2000;
+    volatile float sink = 0.0f;
+    const auto start = juce::Time::getHighResolutionTicks();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < inputs.size(); ++i) outputs[i] = fn(inputs[i]);
+        sink = sink + outputs[(size_t)r % outputs.size()];
+    }
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / ((double)inputs.size() * repeats);
+}
+
+// Compares one FastMath function and the std:: float call it replaces against double precision
+template <typename FastFn, typename ExactFn, typename RefFn>
+bool checkFastMathCase(const char* name, FastFn fast, ExactFn exact, RefFn reference, double lo, double hi, double bound) {
+    static constexpr int numPoints = 1 << 20, speedPoints = 4096;
+
+    double errFast = 0.0, errExact = 0.0;
+    for (int i = 0; i <= numPoints; ++i) {
+        const float x = (float)(lo + (hi - lo) * (double)i / (double)numPoints);
+        const double ref = reference((double)x);
+        errFast = juce::jmax(errFast, std::abs((double)fast(x) - ref));
+        errExact = juce::jmax(errExact, std::abs((double)exact(x) - ref));
+    }
+
+    std::vector<float> inputs(speedPoints), outputs(speedPoints);
+    for (int i = 0; i < speedPoints; ++i) inputs[(size_t)i] = (float)(lo + (hi - lo) * (double)i / (double)speedPoints);
+    const double nsExact = timePerCall(exact, inputs, outputs);
+    const double nsFast = timePerCall(fast, inputs, outputs);
+
+    std::cout << name << "\t" << errFast << "\t" << errExact << "\t" << bound << "\t"
+        << nsExact << "\t" << nsFast << "\t" << nsExact / nsFast << "x" << std::endl;
+    return errFast <= bound;
+}
+
+} // namespace
+
+int checkFastMath() {
+    const double pi = juce::MathConstants<double>::pi;
+    const float piF = juce::MathConstants<float>::pi;
+    bool ok = true;
+
+    // Bounds are the ones documented in FastMath.h, evaluated at the edge of each range
+    std::cout << "function\tmax abs err (fast)\tmax abs err (std float)\tbound\tstd ns/call\tfast ns/call\tspeedup" << std::endl;
+    ok &= checkFastMathCase("tanh", [](float x) { return FastMath::tanh(x); }, [](float x) { return std::tanh(x); },
+        [](double x) { return std::tanh(x); }, -64.0, 64.0, 2.0e-7);
+    ok &= checkFastMathCase("logCosh", [](float x) { return FastMath::logCosh(x); },
+        [](float x) { return std::abs(x) > 10.0f ? std::abs(x) - 0.693147f : std::log(std::cosh(x)); },
+        [](double x) { return std::log(std::cosh(x)); }, -8.0, 8.0, 2.0e-7 + 9.6e-7);
+    ok &= checkFastMathCase("atan", [](float x) { return FastMath::atan(x); }, [](float x) { return std::atan(x); },
+        [](double x) { return std::atan(x); }, -150.0, 150.0, 2.0e-7);
+    ok &= checkFastMathCase("log1p", [](float x) { return FastMath::log1p(x); }, [](float x) { return std::log(1.0f + x); },
+        [](double x) { return std::log1p(x); }, 0.0, 4.0, 2.0e-7 + 1.2e-7);
+    ok &= checkFastMathCase("sinPi", [](float x) { return FastMath::sinPi(x); }, [piF](float x) { return std::sin(x * piF); },
+        [pi](double x) { return std::sin(x * pi); }, -64.0, 64.0, 2.0e-7);
+    ok &= checkFastMathCase("cosPi", [](float x) { return FastMath::cosPi(x); }, [piF](float x) { return std::cos(x * piF); },
+        [pi](double x) { return std::cos(x * pi); }, -8.0, 8.0, 2.0e-7 + 3.0e-6);
+
+    std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
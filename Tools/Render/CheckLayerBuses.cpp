@@ -0,0 +1,106 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+
+namespace RenderModes {
+
+// --- Layer bus check: stems from the same pass, aligned with the main output ---
+// One kick per preset, rendered with the main output only and with every layer bus enabled in
+// both modes. The main output must not change when the buses are on, and the Post Master layers,
+// summed, have to peak in cross-correlation with the main output within lagBound samples (they
+// miss only the saturation). Also prints the cost of the buses and the level of the layer sum.
+
+namespace {
+
+double renderKickAllChannels(NextGenKickAudioProcessor& proc, const Settings& settings, juce::AudioBuffer<float>& output) {
+    const int numChannels = proc.getTotalNumOutputChannels();
+    const int totalSamples = (int)(settings.lengthSeconds * settings.sampleRate);
+    output.setSize(numChannels, totalSamples);
+    proc.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    juce::AudioBuffer<float> block(numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+    const auto start = juce::Time::getHighResolutionTicks();
+    for (int pos = 0; pos < totalSamples; pos += settings.blockSize) {
+        const int n = juce::jmin(settings.blockSize, totalSamples - pos);
+        block.setSize(numChannels, n, false, false, true);
+        block.clear();
+        midi.clear();
+        if (pos == 0) midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), 0);
+        proc.processBlock(block, midi);
+        for (int ch = 0; ch < numChannels; ++ch) output.copyFrom(ch, pos, block, ch, 0, n);
+    }
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    return seconds * 1.0e9 / (double)totalSamples;
+}
+
+} // namespace
+
+int checkLayerBuses(const Settings& settings, const juce::String& presetList) {
+    static constexpr int maxLag = 64, lagBound = 1;
+
+    NextGenKickAudioProcessor mainOnly, withBuses;
+    for (auto* proc : { &mainOnly, &withBuses }) {
+        setUpOffline(*proc, settings.sampleRate, settings.blockSize);
+        proc->useIdleBypass = false; // the layers hold the chain awake longer, which would change when it flushes
+    }
+    withBuses.enableAllBuses();
+    withBuses.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+    if (withBuses.getTotalNumOutputChannels() != 8) {
+        std::cout << "layer buses unavailable (" << withBuses.getTotalNumOutputChannels() << " output channels)\nFAIL" << std::endl;
+        return 1;
+    }
+
+    const auto presets = parseIndexList(presetList, 0, (int)mainOnly.presetList.size() - 1);
+    bool ok = true;
+
+    // Mono sum of channels [first, first + count) at sample i
+    auto monoSum = [](const juce::AudioBuffer<float>& b, int first, int count, int i) {
+        double sum = 0.0;
+        for (int ch = first; ch < first + count; ++ch) sum += b.getSample(ch, i);
+        return sum;
+    };
+
+    std::cout << "preset\tns/smp (main only)\tns/smp (pre)\tns/smp (post)\tmain max diff\tpost lag\tpost sum vs main dB" << std::endl;
+    for (int p : presets) {
+        mainOnly.loadPreset(p);
+        withBuses.loadPreset(p);
+
+        juce::AudioBuffer<float> reference, pre, post;
+        const double mainNs = renderKickAllChannels(mainOnly, settings, reference);
+        setParameter(withBuses, pLayerOutMode, 0.0f);
+        const double preNs = renderKickAllChannels(withBuses, settings, pre);
+        setParameter(withBuses, pLayerOutMode, 1.0f);
+        const double postNs = renderKickAllChannels(withBuses, settings, post);
+
+        float mainDiff = 0.0f;
+        for (const auto* b : { &pre, &post })
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < reference.getNumSamples(); ++i)
+                    mainDiff = juce::jmax(mainDiff, std::abs(b->getSample(ch, i) - reference.getSample(ch, i)));
+
+        const int n = reference.getNumSamples();
+        int bestLag = 0;
+        double bestCorr = -1.0e30, mainEnergy = 0.0, layerEnergy = 0.0;
+        for (int lag = -maxLag; lag <= maxLag; ++lag) {
+            double corr = 0.0;
+            for (int i = juce::jmax(0, -lag); i < juce::jmin(n, n - lag); ++i)
+                corr += monoSum(reference, 0, 2, i + lag) * monoSum(post, 2, 6, i);
+            if (corr > bestCorr) { bestCorr = corr; bestLag = lag; }
+        }
+        for (int i = 0; i < n; ++i) {
+            const double m = monoSum(reference, 0, 2, i), l = monoSum(post, 2, 6, i);
+            mainEnergy += m * m;
+            layerEnergy += l * l;
+        }
+        const double levelDb = 10.0 * std::log10(juce::jmax(layerEnergy, 1.0e-30) / juce::jmax(mainEnergy, 1.0e-30));
+
+        std::cout << p << "\t" << mainNs << "\t" << preNs << "\t" << postNs << "\t" << mainDiff << "\t" << bestLag << "\t" << levelDb << std::endl;
+        ok &= mainDiff == 0.0f && std::abs(bestLag) <= lagBound;
+    }
+
+    std::cout << "main output must match exactly, post lag bound " << lagBound << "\n" << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
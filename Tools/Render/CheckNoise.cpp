@@ -0,0 +1,123 @@
+#include "RenderModes.h"
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace RenderModes {
+
+// --- Noise check: block generator vs. the per-sample generator it replaces ---
+// The same seed has to repeat the same blocks. Per colour, the level and the octave-band spectrum
+// (Welch average of Hann-windowed 4096-point FFTs) have to match the old generator's.
+
+namespace {
+
+// The attack noise before the block generator (juce::Random, Box-Muller), kept as the baseline
+struct BaselineNoise {
+    float next(int type) noexcept {
+        if (type == 0) {
+            if (hasSpare) { hasSpare = false; return spare; }
+            const double twoPi = juce::MathConstants<double>::twoPi;
+            const float u1 = random.nextFloat(), u2 = random.nextFloat();
+            const float mag = std::sqrt(-2.0f * std::log(u1 + 1e-9f));
+            spare = mag * std::sin(twoPi * u2) * 0.4f; hasSpare = true;
+            return (float)(mag * std::cos(twoPi * u2) * 0.4f);
+        }
+        const float w = random.nextFloat() * 2.0f - 1.0f;
+        if (type == 1) {
+            b0 = 0.99886f * b0 + w * 0.0555179f; b1 = 0.99332f * b1 + w * 0.0750312f; b2 = 0.96900f * b2 + w * 0.1538520f;
+            b3 = 0.86650f * b3 + w * 0.3104856f; b4 = 0.55000f * b4 + w * 0.5329522f; b5 = -0.7616f * b5 + w * 0.0168980f;
+            const float p = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * 0.5362f) * 0.11f; b6 = w * 0.11592f; return p;
+        }
+        lastBrown = (lastBrown + 0.02f * w) / 1.02f;
+        return lastBrown * 3.5f;
+    }
+
+    juce::Random random{ 1 };
+    float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0, lastBrown = 0;
+    float spare = 0.0f;
+    bool hasSpare = false;
+};
+
+// Mean power per FFT bin in the octaves around 31.25 Hz .. 16 kHz (at 48 kHz), in dB
+std::array<double, 10> noiseBandsDb(const std::vector<float>& x) {
+    static constexpr int order = 12, size = 1 << order;
+    juce::dsp::FFT fft(order);
+    std::vector<float> window((size_t)size), frame((size_t)(2 * size));
+    for (int i = 0; i < size; ++i) window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)size);
+
+    std::vector<double> power((size_t)(size / 2 + 1), 0.0);
+    int numFrames = 0;
+    for (size_t start = 0; start + (size_t)size <= x.size(); start += size / 2, ++numFrames) {
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        for (int i = 0; i < size; ++i) frame[(size_t)i] = x[start + (size_t)i] * window[(size_t)i];
+        fft.performFrequencyOnlyForwardTransform(frame.data());
+        for (int k = 0; k <= size / 2; ++k) power[(size_t)k] += (double)frame[(size_t)k] * frame[(size_t)k];
+    }
+
+    std::array<double, 10> bands{};
+    const double binHz = 48000.0 / size;
+    for (int b = 0; b < (int)bands.size(); ++b) {
+        const double centre = 31.25 * std::pow(2.0, (double)b);
+        const int lo = juce::jmax(1, (int)std::ceil(centre / std::sqrt(2.0) / binHz)), hi = juce::jmin(size / 2, (int)std::floor(centre * std::sqrt(2.0) / binHz));
+        double sum = 0.0;
+        for (int k = lo; k <= hi; ++k) sum += power[(size_t)k];
+        bands[(size_t)b] = 10.0 * std::log10(sum / (double)((hi - lo + 1) * juce::jmax(1, numFrames)) + 1.0e-30);
+    }
+    return bands;
+}
+
+} // namespace
+
+int checkNoise() {
+    static constexpr int numSamples = 1 << 21, blockSize = 64; // as renderSpan fills it per chunk
+    static constexpr double levelTolerance = 0.1, bandTolerance = 0.5; // dB
+    static const char* names[] = { "white", "pink", "brown" };
+    bool ok = true;
+
+    // Seeding: equal seeds repeat, different seeds do not
+    {
+        std::vector<float> a((size_t)blockSize), b((size_t)blockSize), c((size_t)blockSize);
+        NoiseGenerator g1(42), g2(42), g3(43);
+        g1.fill(1, a.data(), blockSize); g2.fill(1, b.data(), blockSize); g3.fill(1, c.data(), blockSize);
+        const bool repeats = a == b, differs = a != c;
+        std::cout << "seed 42 twice: " << (repeats ? "identical" : "DIFFERENT") << ", seed 43: " << (differs ? "different" : "IDENTICAL") << "\n" << std::endl;
+        ok &= repeats && differs;
+    }
+
+    std::cout << "noise\tRMS old dB\tRMS new dB\tworst band diff dB\told ns/sample\tnew ns/sample\tspeedup" << std::endl;
+    for (int type = 0; type < 3; ++type) {
+        std::vector<float> oldOut((size_t)numSamples), newOut((size_t)numSamples);
+
+        BaselineNoise baseline;
+        auto start = juce::Time::getHighResolutionTicks();
+        for (int pos = 0; pos < numSamples; pos += blockSize)
+            for (int i = 0; i < blockSize; ++i) oldOut[(size_t)(pos + i)] = baseline.next(type);
+        const double nsOld = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / numSamples;
+
+        NoiseGenerator generator(1);
+        start = juce::Time::getHighResolutionTicks();
+        for (int pos = 0; pos < numSamples; pos += blockSize) generator.fill(type, newOut.data() + pos, blockSize);
+        const double nsNew = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / numSamples;
+
+        auto rmsDb = [](const std::vector<float>& x) {
+            double sum = 0.0;
+            for (float v : x) sum += (double)v * v;
+            return 10.0 * std::log10(sum / (double)x.size());
+        };
+        const double rmsOld = rmsDb(oldOut), rmsNew = rmsDb(newOut);
+
+        const auto bandsOld = noiseBandsDb(oldOut), bandsNew = noiseBandsDb(newOut);
+        double worstBand = 0.0;
+        for (size_t b = 0; b < bandsOld.size(); ++b) worstBand = juce::jmax(worstBand, std::abs(bandsNew[b] - bandsOld[b]));
+
+        std::cout << names[type] << "\t" << rmsOld << "\t" << rmsNew << "\t" << worstBand << "\t"
+            << nsOld << "\t" << nsNew << "\t" << nsOld / nsNew << "x" << std::endl;
+        ok &= std::abs(rmsNew - rmsOld) <= levelTolerance && worstBand <= bandTolerance;
+    }
+
+    std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
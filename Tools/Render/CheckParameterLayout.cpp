@@ -0,0 +1,147 @@
+#include "RenderModes.h"
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+namespace RenderModes {
+
+// --- Parameter layout check: the table-generated layout vs. the layout hosts already saved ---
+// Hosts store automation and sessions by parameter index as well as by ID, so the layout built
+// from ParameterTable.h must keep every parameter of the original hand-written layout at its
+// index, with the same ID, name, type, range, default and choices. Anything added since has to
+// come after them.
+
+namespace {
+
+enum class BaselineType { Float, Choice, Bool };
+
+struct BaselineParam {
+    const char* id;
+    const char* name;
+    BaselineType type;
+    float min, max, def, interval, skew;
+    const char* choices; // "|"-separated
+};
+
+// The original createParameterLayout(), in its order
+const BaselineParam baselineLayout[] = {
+    { "atkWave", "Atk Waveform", BaselineType::Choice, 0.0f, 7.0f, 0.0f, 1.0f, 1.0f, "White|Pink|Brown|Square|Saw|Triangle|Pulse|Ultra Sine" },
+    { "atkDecay", "Atk Decay", BaselineType::Float, 0.001f, 0.2f, 0.01f, 0.0f, 1.0f, nullptr },
+    { "atkCurve", "Atk Decay Curve", BaselineType::Float, 0.1f, 10.0f, 2.0f, 0.0f, 1.0f, nullptr },
+    { "atkTone", "Atk Tone (Hi-Cut)", BaselineType::Float, 100.0f, 20000.0f, 20000.0f, 0.0f, 1.0f, nullptr },
+    { "atkLevel", "Atk Level", BaselineType::Float, 0.0f, 1.0f, 0.4f, 0.0f, 1.0f, nullptr },
+    { "atkPan", "Atk Panning", BaselineType::Float, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "atkPitch", "Atk Click Freq", BaselineType::Float, 100.0f, 15000.0f, 3000.0f, 1.0f, 0.25f, nullptr },
+    { "atkHPF", "Atk HighPass", BaselineType::Float, 20.0f, 2000.0f, 200.0f, 0.0f, 1.0f, nullptr },
+    { "atkPulseWidth", "Atk Pulse Width", BaselineType::Float, 0.01f, 0.99f, 0.5f, 0.0f, 1.0f, nullptr },
+
+    { "bodyWave", "Body Waveform", BaselineType::Choice, 0.0f, 4.0f, 0.0f, 1.0f, 1.0f, "Ultra Sine|Bessel|Saw|Square|Triangle" },
+    { "pStart", "Body Pitch Start", BaselineType::Float, 100.0f, 2000.0f, 350.0f, 0.0f, 1.0f, nullptr },
+    { "pEnd", "Body Pitch End", BaselineType::Float, 20.0f, 150.0f, 43.6f, 0.0f, 1.0f, nullptr },
+    { "pDecay", "Body Pitch Decay", BaselineType::Float, 0.01f, 0.5f, 0.07f, 0.0f, 1.0f, nullptr },
+    { "pGlide", "Von Karman Tension", BaselineType::Float, 0.0f, 5.0f, 0.8f, 0.0f, 1.0f, nullptr },
+    { "pCurve", "Body Pitch Curve", BaselineType::Float, 0.1f, 5.0f, 1.0f, 0.0f, 1.0f, nullptr },
+    { "bodyDecay", "Body Amp Decay", BaselineType::Float, 0.05f, 1.5f, 0.35f, 0.0f, 1.0f, nullptr },
+    { "bodyCurve", "Body Amp Curve", BaselineType::Float, 0.1f, 5.0f, 1.0f, 0.0f, 1.0f, nullptr },
+    { "bodyLevel", "Body Level", BaselineType::Float, 0.0f, 1.0f, 0.75f, 0.0f, 1.0f, nullptr },
+    { "bodyPan", "Body Panning", BaselineType::Float, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "besselRatio", "Bessel Ratio", BaselineType::Float, 1.0f, 3.0f, 1.593f, 0.0f, 1.0f, nullptr },
+    { "bodyFilter", "Body LowPass", BaselineType::Float, 100.0f, 12000.0f, 5000.0f, 0.0f, 1.0f, nullptr },
+
+    { "subNote", "Sub Note (MIDI)", BaselineType::Float, 24.0f, 48.0f, 29.0f, 0.0f, 1.0f, nullptr },
+    { "subFine", "Sub Fine Tune (Hz)", BaselineType::Float, -10.0f, 10.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "subTrack", "Key Tracking", BaselineType::Bool, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, nullptr },
+    { "subDecay", "Sub Amp Decay", BaselineType::Float, 0.10f, 5.0f, 0.25f, 0.0f, 1.0f, nullptr },
+    { "subCurve", "Sub Decay Curve", BaselineType::Float, 3.0f, 10.0f, 4.0f, 0.0f, 1.0f, nullptr },
+    { "subLevel", "Sub Level", BaselineType::Float, 0.0f, 1.0f, 0.65f, 0.0f, 1.0f, nullptr },
+    { "subPhase", "Sub Phase Offset", BaselineType::Float, 0.0f, 360.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "subAntiClick", "Sub Anti-Click (ms)", BaselineType::Float, 0.10f, 50.0f, 5.0f, 0.0f, 1.0f, nullptr },
+    { "subPan", "Sub Panning", BaselineType::Float, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, nullptr },
+
+    { "masterDrive", "Master Drive", BaselineType::Float, 1.0f, 25.0f, 1.0f, 0.0f, 1.0f, nullptr },
+    { "satType", "Saturation Mode", BaselineType::Choice, 0.0f, 10.0f, 0.0f, 1.0f, 1.0f, "Soft Tanh|Hard Clip|Triode|Tape|Transformer|JFET|BJT|Wavefold|Bitcrush|Exciter|Cubic" },
+    { "masterOut", "Final Volume", BaselineType::Float, 0.0f, 1.0f, 0.7f, 0.0f, 1.0f, nullptr },
+    { "masterWidth", "Stereo Width", BaselineType::Float, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, nullptr },
+    { "masterRelease", "Note Safety Tail", BaselineType::Float, 3.00f, 20.0f, 5.0f, 0.0f, 1.0f, nullptr },
+    { "masterPhase", "Global Phase Reset", BaselineType::Float, 0.0f, 360.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "limThreshold", "Limiter Threshold (dB)", BaselineType::Float, -12.0f, 0.0f, 0.0f, 0.0f, 1.0f, nullptr },
+    { "limLookahead", "Limiter Look-ahead (ms)", BaselineType::Float, 0.0f, 5.0f, 1.0f, 0.0f, 1.0f, nullptr },
+    { "masterLPF", "Master LowPass", BaselineType::Float, 60.0f, 20000.0f, 20000.0f, 0.0f, 1.0f, nullptr },
+
+    { "osMode", "Oversampling", BaselineType::Choice, 0.0f, 3.0f, 1.0f, 1.0f, 1.0f, "Off|2x (Standard)|4x (High)|8x (Ultra)" },
+};
+
+BaselineType typeOf(juce::RangedAudioParameter& param) {
+    if (dynamic_cast<juce::AudioParameterChoice*>(&param) != nullptr) return BaselineType::Choice;
+    if (dynamic_cast<juce::AudioParameterBool*>(&param) != nullptr) return BaselineType::Bool;
+    return BaselineType::Float;
+}
+
+const char* typeName(BaselineType type) {
+    return type == BaselineType::Choice ? "choice" : type == BaselineType::Bool ? "bool" : "float";
+}
+
+// Every difference between the live parameter and its baseline entry, one per line
+juce::StringArray compareParameter(juce::RangedAudioParameter& param, const BaselineParam& base) {
+    juce::StringArray diffs;
+    auto differs = [](float a, float b, float scale) { return std::abs(a - b) > 1.0e-6f * juce::jmax(1.0f, std::abs(scale)); };
+
+    if (param.getParameterID() != base.id) diffs.add("ID " + param.getParameterID() + ", baseline " + base.id);
+    if (param.getName(1024) != base.name) diffs.add("name \"" + param.getName(1024) + "\", baseline \"" + base.name + "\"");
+    if (typeOf(param) != base.type) diffs.add(juce::String("type ") + typeName(typeOf(param)) + ", baseline " + typeName(base.type));
+
+    const auto& range = param.getNormalisableRange();
+    if (differs(range.start, base.min, base.max) || differs(range.end, base.max, base.max) || differs(range.interval, base.interval, base.max)
+        || differs(range.skew, base.skew, 1.0f))
+        diffs.add("range " + juce::String(range.start) + ".." + juce::String(range.end) + " interval " + juce::String(range.interval) + " skew " + juce::String(range.skew)
+            + ", baseline " + juce::String(base.min) + ".." + juce::String(base.max) + " interval " + juce::String(base.interval) + " skew " + juce::String(base.skew));
+
+    // The host sees the normalized default; compare it in plain units, as the layout spelled it
+    const float def = param.convertFrom0to1(param.getDefaultValue());
+    if (differs(def, base.def, base.max - base.min)) diffs.add("default " + juce::String(def) + ", baseline " + juce::String(base.def));
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(&param))
+        if (base.choices != nullptr && choice->choices.joinIntoString("|") != base.choices)
+            diffs.add("choices " + choice->choices.joinIntoString("|") + ", baseline " + base.choices);
+    return diffs;
+}
+
+} // namespace
+
+int checkParameterLayout() {
+    NextGenKickAudioProcessor proc;
+    const auto& params = proc.getParameters();
+    const int numBaseline = (int)std::size(baselineLayout);
+    int failures = 0;
+
+    std::cout << "index\tID\tresult" << std::endl;
+    for (int i = 0; i < params.size(); ++i) {
+        auto* param = dynamic_cast<juce::RangedAudioParameter*>(params[i]);
+        const juce::String id = param != nullptr ? param->getParameterID() : juce::String("?");
+        juce::StringArray diffs;
+        if (param == nullptr) diffs.add("not a ranged parameter");
+        else if (params[i]->getParameterIndex() != i) diffs.add("reports index " + juce::String(params[i]->getParameterIndex()));
+        if (param != nullptr && i < numBaseline) diffs.addArray(compareParameter(*param, baselineLayout[i]));
+
+        // Added parameters must not reuse a baseline ID at a new index
+        if (i >= numBaseline)
+            for (const auto& base : baselineLayout)
+                if (id == base.id) diffs.add("baseline ID moved here");
+
+        if (diffs.isEmpty()) std::cout << i << "\t" << id.toRawUTF8() << "\t" << (i < numBaseline ? "same as baseline" : "added") << std::endl;
+        for (auto& diff : diffs) std::cout << i << "\t" << id.toRawUTF8() << "\tDIFFERS: " << diff.toRawUTF8() << std::endl;
+        failures += diffs.isEmpty() ? 0 : 1;
+    }
+
+    if (params.size() < numBaseline) {
+        std::cout << "Layout has " << params.size() << " parameters, baseline " << numBaseline << std::endl;
+        ++failures;
+    }
+
+    const bool ok = failures == 0;
+    std::cout << juce::jmin(numBaseline, params.size()) << " baseline parameters compared, " << juce::jmax(0, params.size() - numBaseline)
+        << " added after them, " << failures << " mismatched\n" << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace RenderModes
@@ -0,0 +1,180 @@
+#include "GoldenTest.h"
+#include "RenderHarness.h"
+#include <array>
+#include <cmath>
+#include <iostream>
+
+namespace GoldenTest {
+
+namespace {
+
+static constexpr int numOsModes = 4;
+static constexpr int numBands = 10;   // octaves centred on 31.25 Hz .. 16 kHz
+static constexpr int numProbes = 64;  // sample values at evenly spaced positions
+static constexpr int note = 36;
+static constexpr int blockSize = 512;
+
+// Allowed differences
+static constexpr double levelToleranceDb = 0.1;  // peak and RMS
+static constexpr double bandToleranceDb = 0.5;
+static constexpr double bandFloorDb = -90.0;     // bands below this in both renders are not compared
+static constexpr double probeTolerance = 1.0e-3; // absolute, per probed sample
+
+struct Fingerprint {
+    double peakDb = 0.0, rmsDb = 0.0;
+    std::array<double, numBands> bandsDb{};
+    std::array<double, numProbes> probes{};
+};
+
+double toDb(double gain) { return 20.0 * std::log10(std::max(gain, 1.0e-10)); }
+
+// One note from a freshly prepared processor (mono mix of the output, latency included)
+std::vector<float> render(NextGenKickAudioProcessor& proc, int preset, int osMode, double sampleRate, double lengthSeconds) {
+    RenderHarness::setUpOffline(proc, sampleRate, blockSize, preset);
+    RenderHarness::setParameter(proc, pOsMode, (float)osMode);
+    proc.prepareToPlay(sampleRate, blockSize);
+
+    const int totalSamples = (int)std::ceil(lengthSeconds * sampleRate);
+    std::vector<float> out((size_t)totalSamples);
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midi;
+
+    for (int pos = 0; pos < totalSamples; pos += blockSize) {
+        const int n = juce::jmin(blockSize, totalSamples - pos);
+        block.setSize(2, n, false, false, true);
+        block.clear();
+        midi.clear();
+        if (pos == 0) midi.addEvent(juce::MidiMessage::noteOn(1, note, (juce::uint8)127), 0);
+        proc.processBlock(block, midi);
+        for (int i = 0; i < n; ++i) out[(size_t)(pos + i)] = 0.5f * (block.getSample(0, i) + block.getSample(1, i));
+    }
+    return out;
+}
+
+Fingerprint fingerprint(const std::vector<float>& x, double sampleRate) {
+    Fingerprint f;
+    double peak = 0.0, sumSquares = 0.0;
+    for (float v : x) { peak = std::max(peak, (double)std::abs(v)); sumSquares += (double)v * v; }
+    f.peakDb = toDb(peak);
+    f.rmsDb = toDb(std::sqrt(sumSquares / (double)std::max<size_t>(1, x.size())));
+
+    // Octave-band energies from one zero-padded FFT over the whole render
+    int order = 1;
+    while ((1 << order) < (int)x.size()) ++order;
+    juce::dsp::FFT fft(order);
+    std::vector<float> spectrum((size_t)(2 << order), 0.0f);
+    std::copy(x.begin(), x.end(), spectrum.begin());
+    fft.performFrequencyOnlyForwardTransform(spectrum.data());
+
+    const double binHz = sampleRate / (double)(1 << order);
+    for (int b = 0; b < numBands; ++b) {
+        const double centre = 31.25 * std::pow(2.0, (double)b);
+        const int lo = (int)std::ceil(centre / std::sqrt(2.0) / binHz), hi = (int)std::floor(centre * std::sqrt(2.0) / binHz);
+        double energy = 0.0;
+        for (int k = juce::jmax(1, lo); k <= juce::jmin(hi, (1 << order) / 2); ++k) energy += (double)spectrum[(size_t)k] * spectrum[(size_t)k];
+        f.bandsDb[(size_t)b] = 10.0 * std::log10(std::max(energy / (double)x.size(), 1.0e-20));
+    }
+
+    for (int p = 0; p < numProbes; ++p) f.probes[(size_t)p] = x[(size_t)p * x.size() / numProbes];
+    return f;
+}
+
+juce::var toVar(int preset, int osMode, const Fingerprint& f) {
+    auto* record = new juce::DynamicObject();
+    record->setProperty("preset", preset);
+    record->setProperty("osMode", osMode);
+    record->setProperty("peakDb", f.peakDb);
+    record->setProperty("rmsDb", f.rmsDb);
+    juce::Array<juce::var> bands, probes;
+    for (double v : f.bandsDb) bands.add(v);
+    for (double v : f.probes) probes.add(v);
+    record->setProperty("bandsDb", bands);
+    record->setProperty("probes", probes);
+    return juce::var(record);
+}
+
+Fingerprint fromVar(const juce::var& record) {
+    Fingerprint f;
+    f.peakDb = record["peakDb"];
+    f.rmsDb = record["rmsDb"];
+    if (auto* bands = record["bandsDb"].getArray())
+        for (int b = 0; b < juce::jmin(numBands, bands->size()); ++b) f.bandsDb[(size_t)b] = (*bands)[b];
+    if (auto* probes = record["probes"].getArray())
+        for (int p = 0; p < juce::jmin(numProbes, probes->size()); ++p) f.probes[(size_t)p] = (*probes)[p];
+    return f;
+}
+
+// Describes every difference beyond the tolerances; empty when the render matches
+juce::String compare(const Fingerprint& ref, const Fingerprint& now) {
+    juce::StringArray problems;
+    if (std::abs(now.peakDb - ref.peakDb) > levelToleranceDb) problems.add("peak " + juce::String(ref.peakDb, 2) + " -> " + juce::String(now.peakDb, 2) + " dB");
+    if (std::abs(now.rmsDb - ref.rmsDb) > levelToleranceDb) problems.add("RMS " + juce::String(ref.rmsDb, 2) + " -> " + juce::String(now.rmsDb, 2) + " dB");
+
+    for (int b = 0; b < numBands; ++b) {
+        const double r = ref.bandsDb[(size_t)b], n = now.bandsDb[(size_t)b];
+        if ((r > bandFloorDb || n > bandFloorDb) && std::abs(n - r) > bandToleranceDb)
+            problems.add("band " + juce::String(31.25 * std::pow(2.0, (double)b), 0) + " Hz " + juce::String(r, 1) + " -> " + juce::String(n, 1) + " dB");
+    }
+
+    double worstProbe = 0.0;
+    for (int p = 0; p < numProbes; ++p) worstProbe = std::max(worstProbe, std::abs(now.probes[(size_t)p] - ref.probes[(size_t)p]));
+    if (worstProbe > probeTolerance) problems.add("sample error " + juce::String(worstProbe, 6));
+
+    return problems.joinIntoString(", ");
+}
+
+} // namespace
+
+int run(const Options& options) {
+    NextGenKickAudioProcessor proc;
+
+    if (options.update) {
+        auto presets = options.presets;
+        if (presets.empty())
+            for (int p = 0; p < (int)proc.presetList.size(); ++p) presets.push_back(p);
+
+        juce::Array<juce::var> cases;
+        for (int p : presets)
+            for (int os = 0; os < numOsModes; ++os)
+                cases.add(toVar(p, os, fingerprint(render(proc, p, os, options.sampleRate, options.lengthSeconds), options.sampleRate)));
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("sampleRate", options.sampleRate);
+        root->setProperty("lengthSeconds", options.lengthSeconds);
+        root->setProperty("cases", cases);
+        if (!options.referenceFile.replaceWithText(juce::JSON::toString(juce::var(root)))) {
+            std::cerr << "Cannot write " << options.referenceFile.getFullPathName().toRawUTF8() << std::endl;
+            return 1;
+        }
+        std::cout << cases.size() << " fingerprints written to " << options.referenceFile.getFullPathName().toRawUTF8() << std::endl;
+        return 0;
+    }
+
+    const auto reference = juce::JSON::parse(options.referenceFile);
+    const auto* cases = reference["cases"].getArray();
+    if (cases == nullptr) {
+        std::cerr << "No fingerprints in " << options.referenceFile.getFullPathName().toRawUTF8() << " (create them with --update-golden)" << std::endl;
+        return 1;
+    }
+
+    const double sampleRate = reference["sampleRate"], lengthSeconds = reference["lengthSeconds"];
+    int numChecked = 0, numFailed = 0;
+    for (const auto& record : *cases) {
+        const int p = record["preset"], os = record["osMode"];
+        if (p < 0 || p >= (int)proc.presetList.size()) continue;
+        if (!options.presets.empty() && std::find(options.presets.begin(), options.presets.end(), p) == options.presets.end()) continue;
+
+        const auto problems = compare(fromVar(record), fingerprint(render(proc, p, os, sampleRate, lengthSeconds), sampleRate));
+        ++numChecked;
+        if (problems.isNotEmpty()) {
+            ++numFailed;
+            std::cout << "preset " << p << " (" << proc.presetList[(size_t)p].name.toRawUTF8() << ") osMode " << os << ": " << problems.toRawUTF8() << std::endl;
+        }
+    }
+
+    std::cout << numChecked << " renders checked, " << numFailed << " differ from the reference" << std::endl;
+    std::cout << (numFailed == 0 ? "PASS" : "FAIL") << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+} // namespace GoldenTest
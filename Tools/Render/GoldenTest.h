@@ -0,0 +1,22 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// --- Golden-output check ---
+// Renders every built-in preset under every oversampling mode with seeded noise and compares each
+// render against a stored fingerprint: peak, RMS, octave-band energies and a set of sample values
+// at fixed positions. A faster DSP path has to pass this before it replaces the old one.
+namespace GoldenTest {
+
+struct Options {
+    juce::File referenceFile;
+    bool update = false;           // write new fingerprints instead of checking
+    std::vector<int> presets;      // empty: every preset in the reference (or every preset when updating)
+    double sampleRate = 48000.0;   // update only; a check uses the reference's settings
+    double lengthSeconds = 1.0;
+};
+
+// Returns the exit code: 0 when every case matches (or the reference was written)
+int run(const Options& options);
+
+} // namespace GoldenTest
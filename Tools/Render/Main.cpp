@@ -0,0 +1,316 @@
+// NextGenKickRender - headless batch renderer (presets x notes -> WAV)
+//
+// Drives NextGenKickAudioProcessor through loadPreset()/processBlock() without an editor
+// (only --bench-editor creates one, painted offscreen).
+// Every worker thread owns one processor instance and pulls jobs from a shared queue.
+// The check and benchmark modes each live in their own file (RenderModes.h); main() dispatches.
+//
+// Usage:
+//   NextGenKickRender --out=<dir> [--presets=all|0,3,10-20] [--notes=36|24-48]
+//                     [--rate=48000] [--block=512] [--length=2.0] [--bits=24] [--threads=N] [--exact-math] [--stem-cache] [--seed=1]
+//   NextGenKickRender --list
+//   NextGenKickRender --check-envelopes
+//   NextGenKickRender --check-fastmath
+//   NextGenKickRender --check-noise
+//   NextGenKickRender --check-wavetables
+//   NextGenKickRender --check-filters
+//   NextGenKickRender --check-parameter-layout
+//   NextGenKickRender --bench-kernels [--rate=48000] [--block=512] [--length=1.0]
+//   NextGenKickRender --bench-blocksizes [--rate=48000] [--length=1.0] [--presets=0]
+//   NextGenKickRender --audit-realtime [--rate=48000] [--length=0.25] [--presets=all]
+//   NextGenKickRender --bench-limiter [--rate=48000]
+//   NextGenKickRender --bench-stemcache [--rate=48000] [--block=512] [--length=1.0] [--presets=all]
+//   NextGenKickRender --bench-idle [--rate=48000] [--block=512] [--length=8.0] [--presets=all]
+//   NextGenKickRender --check-layer-buses [--rate=48000] [--block=512] [--length=1.0] [--presets=all]
+//   NextGenKickRender --bench-editor [--rate=48000] [--length=5.0]
+//   NextGenKickRender --bench-presets [--passes=5] [--presets=all]
+//   NextGenKickRender --bench-suite [--rate=48000] [--length=0.25] [--passes=3] [--presets=all] [--os=all] [--sat=all]
+//                     [--blocks=64,512] [--kernels-only] [--json=<file>]
+//   NextGenKickRender --bench-compare --baseline=<file> --current=<file> [--tolerance=5]
+//   NextGenKickRender --check-golden [--golden=Tools/Render/GoldenFingerprints.json] [--presets=all]
+//   NextGenKickRender --update-golden [--golden=Tools/Render/GoldenFingerprints.json] [--presets=all] [--rate=48000] [--length=1.0]
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "BenchmarkSuite.h"
+#include "GoldenTest.h"
+#include "RenderModes.h"
+#include <iostream>
+
+using namespace RenderHarness;
+
+namespace {
+
+struct RenderJob {
+    int presetIndex;
+    int note;
+};
+
+// Headroom rendered past the requested length so the reported latency (OS + lookahead) can be trimmed
+static constexpr int latencyMargin = 8192;
+
+juce::CriticalSection& getLogLock() {
+    static juce::CriticalSection lock;
+    return lock;
+}
+
+juce::String makeFileName(int presetIndex, const juce::String& presetName, int note) {
+    auto safeName = presetName.replaceCharacters(" /\\:*?\"<>|", "__________");
+    return juce::String(presetIndex).paddedLeft('0', 3) + "_" + safeName + "_" + juce::String(note) + ".wav";
+}
+
+bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer, int startSample, int numSamples, double sampleRate, int bitDepth) {
+    file.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+    if (stream == nullptr || !stream->openedOk()) return false;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, (unsigned int)buffer.getNumChannels(), bitDepth, {}, 0));
+    if (writer == nullptr) return false;
+    stream.release(); // owned by the writer now
+
+    return writer->writeFromAudioSampleBuffer(buffer, startSample, numSamples);
+}
+
+// --- Worker: one processor instance, pulls jobs until the queue is empty ---
+class RenderWorker : public juce::Thread {
+public:
+    RenderWorker(int workerIndex, NextGenKickAudioProcessor& proc, const Settings& s,
+        const std::vector<RenderJob>& jobList, std::atomic<int>& nextJobIndex, std::atomic<int>& failed)
+        : juce::Thread("NGK Render " + juce::String(workerIndex)),
+        processor(proc), settings(s), jobs(jobList), nextJob(nextJobIndex), numFailed(failed)
+    {
+    }
+
+    void run() override {
+        const int lengthSamples = (int)std::ceil(settings.lengthSeconds * settings.sampleRate);
+        const int totalSamples = lengthSamples + latencyMargin;
+
+        juce::AudioBuffer<float> rendered(2, totalSamples);
+        juce::AudioBuffer<float> block(2, settings.blockSize);
+        juce::MidiBuffer midi;
+
+        for (;;) {
+            const int jobIndex = nextJob.fetch_add(1);
+            if (jobIndex >= (int)jobs.size() || threadShouldExit()) break;
+            const auto& job = jobs[(size_t)jobIndex];
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+
+            processor.loadPreset(job.presetIndex);
+            processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+            for (int pos = 0; pos < totalSamples; pos += settings.blockSize) {
+                const int n = juce::jmin(settings.blockSize, totalSamples - pos);
+                block.setSize(2, n, false, false, true);
+                block.clear();
+                midi.clear();
+                if (pos == 0) midi.addEvent(juce::MidiMessage::noteOn(1, job.note, (juce::uint8)127), 0);
+
+                processor.processBlock(block, midi);
+
+                rendered.copyFrom(0, pos, block, 0, 0, n);
+                rendered.copyFrom(1, pos, block, 1, 0, n);
+            }
+
+            busySeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+            renderedSeconds += (double)totalSamples / settings.sampleRate;
+
+            // Drop the reported latency so every one-shot starts on its first sample
+            const int latency = juce::jlimit(0, latencyMargin, processor.getLatencySamples());
+            const auto& name = processor.presetList[(size_t)job.presetIndex].name;
+            auto file = settings.outDir.getChildFile(makeFileName(job.presetIndex, name, job.note));
+            const bool ok = writeWav(file, rendered, latency, lengthSamples, settings.sampleRate, settings.bitDepth);
+            if (!ok) ++numFailed;
+
+            const juce::ScopedLock sl(getLogLock());
+            std::cout << (ok ? "  " : "  FAILED ") << file.getFileName().toRawUTF8() << std::endl;
+        }
+    }
+
+    double busySeconds = 0.0;     // wall time spent inside render calls on this worker
+    double renderedSeconds = 0.0; // audio seconds produced, including the latency margin
+
+private:
+    NextGenKickAudioProcessor& processor;
+    const Settings& settings;
+    const std::vector<RenderJob>& jobs;
+    std::atomic<int>& nextJob;
+    std::atomic<int>& numFailed;
+};
+
+void printUsage() {
+    std::cout << "NextGenKickRender --out=<dir> [--presets=all|0,3,10-20] [--notes=36|24-48]\n"
+        "                  [--rate=48000] [--block=512] [--length=2.0] [--bits=24] [--threads=N] [--exact-math] [--stem-cache] [--seed=1]\n"
+        "NextGenKickRender --list\n"
+        "NextGenKickRender --check-envelopes\n"
+        "NextGenKickRender --check-fastmath\n"
+        "NextGenKickRender --check-noise\n"
+        "NextGenKickRender --check-wavetables\n"
+        "NextGenKickRender --check-filters\n"
+        "NextGenKickRender --check-parameter-layout\n"
+        "NextGenKickRender --bench-kernels [--rate=48000] [--block=512] [--length=1.0]\n"
+        "NextGenKickRender --bench-blocksizes [--rate=48000] [--length=1.0] [--presets=0]\n"
+        "NextGenKickRender --audit-realtime [--rate=48000] [--length=0.25] [--presets=all]\n"
+        "NextGenKickRender --bench-limiter [--rate=48000]\n"
+        "NextGenKickRender --bench-stemcache [--rate=48000] [--block=512] [--length=1.0] [--presets=all]\n"
+        "NextGenKickRender --bench-idle [--rate=48000] [--block=512] [--length=8.0] [--presets=all]\n"
+        "NextGenKickRender --check-layer-buses [--rate=48000] [--block=512] [--length=1.0] [--presets=all]\n"
+        "NextGenKickRender --bench-editor [--rate=48000] [--length=5.0]\n"
+        "NextGenKickRender --bench-presets [--passes=5] [--presets=all]\n"
+        "NextGenKickRender --bench-suite [--rate=48000] [--length=0.25] [--passes=3] [--presets=all] [--os=all] [--sat=all]\n"
+        "                  [--blocks=64,512] [--kernels-only] [--json=<file>]\n"
+        "NextGenKickRender --bench-compare --baseline=<file> --current=<file> [--tolerance=5]\n"
+        "NextGenKickRender --check-golden [--golden=Tools/Render/GoldenFingerprints.json] [--presets=all]\n"
+        "NextGenKickRender --update-golden [--golden=Tools/Render/GoldenFingerprints.json] [--presets=all] [--rate=48000] [--length=1.0]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h")) { printUsage(); return 0; }
+
+    if (args.containsOption("--check-envelopes")) return RenderModes::checkEnvelopes();
+
+    if (args.containsOption("--check-fastmath")) return RenderModes::checkFastMath();
+
+    if (args.containsOption("--check-noise")) return RenderModes::checkNoise();
+
+    if (args.containsOption("--check-wavetables")) return RenderModes::checkWavetables();
+
+    if (args.containsOption("--check-filters")) return RenderModes::checkFilters();
+
+    if (args.containsOption("--check-parameter-layout")) return RenderModes::checkParameterLayout();
+
+    if (args.containsOption("--bench-kernels")) return RenderModes::benchKernels(readSettings(args, 1.0));
+
+    if (args.containsOption("--bench-blocksizes")) return RenderModes::benchBlockSizes(readSettings(args, 1.0), args.containsOption("--presets") ? args.getValueForOption("--presets") : juce::String("0"));
+
+    if (args.containsOption("--bench-limiter")) return RenderModes::benchLimiter(readSettings(args, 1.0).sampleRate);
+
+    if (args.containsOption("--bench-stemcache")) return RenderModes::benchStemCache(readSettings(args, 1.0), args.getValueForOption("--presets"));
+
+    if (args.containsOption("--bench-idle")) return RenderModes::benchIdle(readSettings(args, 8.0, 1.0, 60.0), args.getValueForOption("--presets"));
+
+    if (args.containsOption("--check-layer-buses")) return RenderModes::checkLayerBuses(readSettings(args, 1.0), args.getValueForOption("--presets"));
+
+    if (args.containsOption("--bench-editor")) return RenderModes::benchEditor(readSettings(args, 5.0));
+
+    if (args.containsOption("--bench-presets")) {
+        const int passes = args.containsOption("--passes") ? juce::jlimit(1, 100, args.getValueForOption("--passes").getIntValue()) : 5;
+        return RenderModes::benchPresets(args.getValueForOption("--presets"), passes);
+    }
+
+    if (args.containsOption("--bench-suite")) {
+        const int numPresets = (int)NextGenKickAudioProcessor().presetList.size();
+        BenchmarkSuite::Options options;
+        if (args.containsOption("--rate"))   options.sampleRate = juce::jlimit(22050.0, 192000.0, args.getValueForOption("--rate").getDoubleValue());
+        if (args.containsOption("--length")) options.lengthSeconds = juce::jlimit(0.05, 30.0, args.getValueForOption("--length").getDoubleValue());
+        if (args.containsOption("--passes")) options.passes = juce::jlimit(1, 100, args.getValueForOption("--passes").getIntValue());
+        options.presets = parseIndexList(args.getValueForOption("--presets"), 0, numPresets - 1);
+        options.osModes = parseIndexList(args.getValueForOption("--os"), 0, 3);
+        options.satTypes = parseIndexList(args.getValueForOption("--sat"), 0, 10);
+        options.blockSizes = parseIndexList(args.containsOption("--blocks") ? args.getValueForOption("--blocks") : juce::String("64,512"), 1, 8192);
+        options.kernelsOnly = args.containsOption("--kernels-only");
+        if (args.containsOption("--json")) options.jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"));
+        return BenchmarkSuite::run(options);
+    }
+
+    if (args.containsOption("--bench-compare")) {
+        if (!args.containsOption("--baseline") || !args.containsOption("--current")) { printUsage(); return 1; }
+        const auto cwd = juce::File::getCurrentWorkingDirectory();
+        const double tolerance = args.containsOption("--tolerance") ? juce::jmax(0.0, args.getValueForOption("--tolerance").getDoubleValue()) : 5.0;
+        return BenchmarkSuite::compare(cwd.getChildFile(args.getValueForOption("--baseline")), cwd.getChildFile(args.getValueForOption("--current")), tolerance);
+    }
+
+    if (args.containsOption("--check-golden|--update-golden")) {
+        const int numPresets = (int)NextGenKickAudioProcessor().presetList.size();
+        GoldenTest::Options options;
+        options.update = args.containsOption("--update-golden");
+        options.referenceFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+            args.containsOption("--golden") ? args.getValueForOption("--golden") : juce::String("Tools/Render/GoldenFingerprints.json"));
+        if (args.containsOption("--presets")) options.presets = parseIndexList(args.getValueForOption("--presets"), 0, numPresets - 1);
+        if (args.containsOption("--rate"))   options.sampleRate = juce::jlimit(22050.0, 192000.0, args.getValueForOption("--rate").getDoubleValue());
+        if (args.containsOption("--length")) options.lengthSeconds = juce::jlimit(0.05, 30.0, args.getValueForOption("--length").getDoubleValue());
+        return GoldenTest::run(options);
+    }
+
+    if (args.containsOption("--audit-realtime")) return RenderModes::auditRealtime(readSettings(args, 0.25), args.getValueForOption("--presets"));
+
+    if (args.containsOption("--list")) {
+        NextGenKickAudioProcessor proc;
+        for (int i = 0; i < (int)proc.presetList.size(); ++i)
+            std::cout << i << "\t" << proc.presetList[(size_t)i].name.toRawUTF8() << "\n";
+        return 0;
+    }
+
+    if (!args.containsOption("--out")) { printUsage(); return 1; }
+
+    auto settings = readSettings(args, 2.0);
+    settings.outDir = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--out"));
+    if (args.containsOption("--bits"))   settings.bitDepth = args.getValueForOption("--bits").getIntValue() == 16 ? 16 : 24;
+
+    int numThreads = juce::SystemStats::getNumCpus();
+    if (args.containsOption("--threads")) numThreads = juce::jmax(1, args.getValueForOption("--threads").getIntValue());
+
+    if (!settings.outDir.isDirectory() && !settings.outDir.createDirectory()) {
+        std::cerr << "Cannot create output directory " << settings.outDir.getFullPathName().toRawUTF8() << std::endl;
+        return 1;
+    }
+
+    // One processor per worker, created here on the message thread
+    std::vector<std::unique_ptr<NextGenKickAudioProcessor>> processors;
+    processors.push_back(std::make_unique<NextGenKickAudioProcessor>());
+    const int numPresets = (int)processors[0]->presetList.size();
+
+    auto presets = parseIndexList(args.getValueForOption("--presets"), 0, numPresets - 1);
+    auto notes = parseIndexList(args.containsOption("--notes") ? args.getValueForOption("--notes") : juce::String("36"), 0, 127);
+
+    std::vector<RenderJob> jobs;
+    for (int p : presets)
+        for (int n : notes) jobs.push_back({ p, n });
+
+    if (jobs.empty()) { std::cerr << "Nothing to render." << std::endl; return 1; }
+
+    numThreads = juce::jmin(numThreads, (int)jobs.size());
+    while ((int)processors.size() < numThreads) processors.push_back(std::make_unique<NextGenKickAudioProcessor>());
+
+    for (auto& proc : processors) {
+        setUpOffline(*proc, settings.sampleRate, settings.blockSize);
+        proc->useFastSaturationMath = !args.containsOption("--exact-math");
+        // Off by default: whether a stem is ready depends on the render thread's timing
+        proc->useStemCache = args.containsOption("--stem-cache");
+        // Every one-shot starts its noise from the same seed, so a rerun writes identical files
+        proc->noiseSeed = args.containsOption("--seed") ? juce::jmax<juce::int64>(1, args.getValueForOption("--seed").getLargeIntValue()) : 1;
+    }
+
+    std::cout << "Rendering " << jobs.size() << " one-shots (" << presets.size() << " presets x " << notes.size()
+        << " notes) on " << numThreads << " threads" << std::endl;
+
+    std::atomic<int> nextJob{ 0 };
+    std::atomic<int> numFailed{ 0 };
+    std::vector<std::unique_ptr<RenderWorker>> workers;
+    for (int i = 0; i < numThreads; ++i)
+        workers.push_back(std::make_unique<RenderWorker>(i, *processors[(size_t)i], settings, jobs, nextJob, numFailed));
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    for (auto& w : workers) w->startThread();
+    for (auto& w : workers) w->waitForThreadToExit(-1);
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    // --- Throughput report ---
+    double busySeconds = 0.0, renderedSeconds = 0.0;
+    for (auto& w : workers) { busySeconds += w->busySeconds; renderedSeconds += w->renderedSeconds; }
+
+    const double rtfPerCore = busySeconds > 0.0 ? renderedSeconds / busySeconds : 0.0;
+    const double rtfTotal = wallSeconds > 0.0 ? renderedSeconds / wallSeconds : 0.0;
+
+    std::cout << "\nRendered " << renderedSeconds << " s of audio in " << wallSeconds << " s wall time\n"
+        << "Realtime factor per core: " << rtfPerCore << "x\n"
+        << "Realtime factor total:    " << rtfTotal << "x (" << numThreads << " threads)" << std::endl;
+
+    return numFailed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#include "RealtimeAudit.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+namespace {
+
+// Plain thread_local bool: no constructor, so reading it never allocates
+thread_local bool inAudioThread = false;
+std::atomic<int> numAllocations{ 0 }, numDeallocations{ 0 }, numLocks{ 0 };
+
+inline void noteAllocation() noexcept { if (inAudioThread) numAllocations.fetch_add(1, std::memory_order_relaxed); }
+inline void noteDeallocation() noexcept { if (inAudioThread) numDeallocations.fetch_add(1, std::memory_order_relaxed); }
+inline void noteLock() noexcept { if (inAudioThread) numLocks.fetch_add(1, std::memory_order_relaxed); }
+
+} // namespace
+
+namespace RealtimeAudit {
+
+ScopedAudioThread::ScopedAudioThread() noexcept { inAudioThread = true; }
+ScopedAudioThread::~ScopedAudioThread() noexcept { inAudioThread = false; }
+
+Counts getCounts() noexcept {
+    Counts c;
+    c.allocations = numAllocations.load();
+    c.deallocations = numDeallocations.load();
+    c.locks = numLocks.load();
+    return c;
+}
+
+void resetCounts() noexcept {
+    numAllocations = 0;
+    numDeallocations = 0;
+    numLocks = 0;
+}
+
+bool canSeeLocks() noexcept {
+#if JUCE_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace RealtimeAudit
+
+#if JUCE_LINUX
+// --- glibc: interpose the C allocator (operator new ends up here too) and the mutex calls ---
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+
+void* malloc(size_t size) { noteAllocation(); return __libc_malloc(size); }
+void* calloc(size_t n, size_t size) { noteAllocation(); return __libc_calloc(n, size); }
+void* realloc(void* p, size_t size) { noteAllocation(); return __libc_realloc(p, size); }
+void* aligned_alloc(size_t alignment, size_t size) { noteAllocation(); return __libc_memalign(alignment, size); }
+void* memalign(size_t alignment, size_t size) { noteAllocation(); return __libc_memalign(alignment, size); }
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    noteAllocation();
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr || size == 0 ? 0 : ENOMEM;
+}
+
+void free(void* p) {
+    if (p != nullptr) noteDeallocation();
+    __libc_free(p);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* m) {
+    using LockFn = int (*)(pthread_mutex_t*);
+    static const auto next = (LockFn)dlsym(RTLD_NEXT, "pthread_mutex_lock");
+    noteLock();
+    return next(m);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* m) {
+    using LockFn = int (*)(pthread_mutex_t*);
+    static const auto next = (LockFn)dlsym(RTLD_NEXT, "pthread_mutex_trylock");
+    noteLock();
+    return next(m);
+}
+}
+#else
+// --- Elsewhere: replace the global operator new/delete ---
+void* operator new(std::size_t size) {
+    noteAllocation();
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    noteAllocation();
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { if (p != nullptr) noteDeallocation(); std::free(p); }
+void operator delete[](void* p) noexcept { if (p != nullptr) noteDeallocation(); std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { if (p != nullptr) noteDeallocation(); std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { if (p != nullptr) noteDeallocation(); std::free(p); }
+#endif
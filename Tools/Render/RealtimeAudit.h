@@ -0,0 +1,26 @@
+#pragma once
+#include <JuceHeader.h>
+
+// --- Real-time safety audit ---
+// Counts heap and lock calls made while a thread is marked as the audio thread.
+// Linux interposes malloc/free and pthread_mutex_lock, so every allocation and lock is seen
+// (C++, JUCE HeapBlock, std::mutex, CriticalSection). Other platforms only replace the global
+// operator new/delete and cannot see locks.
+namespace RealtimeAudit {
+
+struct Counts {
+    int allocations = 0, deallocations = 0, locks = 0;
+    bool any() const noexcept { return allocations + deallocations + locks > 0; }
+};
+
+// Marks the calling thread as the audio thread for the lifetime of the scope
+struct ScopedAudioThread {
+    ScopedAudioThread() noexcept;
+    ~ScopedAudioThread() noexcept;
+};
+
+Counts getCounts() noexcept;
+void resetCounts() noexcept;
+bool canSeeLocks() noexcept;
+
+} // namespace RealtimeAudit
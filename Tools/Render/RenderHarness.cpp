@@ -0,0 +1,72 @@
+#include "RenderHarness.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RenderHarness {
+
+Settings readSettings(const juce::ArgumentList& args, double lengthSeconds, double minLength, double maxLength) {
+    Settings s;
+    s.lengthSeconds = lengthSeconds;
+    if (args.containsOption("--rate"))   s.sampleRate = juce::jlimit(22050.0, 192000.0, args.getValueForOption("--rate").getDoubleValue());
+    if (args.containsOption("--block"))  s.blockSize = juce::jlimit(1, 8192, args.getValueForOption("--block").getIntValue());
+    if (args.containsOption("--length")) s.lengthSeconds = juce::jlimit(minLength, maxLength, args.getValueForOption("--length").getDoubleValue());
+    return s;
+}
+
+std::vector<int> parseIndexList(const juce::String& text, int minVal, int maxVal) {
+    std::vector<int> result;
+    if (text.isEmpty() || text.trim().toLowerCase() == "all") {
+        for (int i = minVal; i <= maxVal; ++i) result.push_back(i);
+        return result;
+    }
+
+    juce::StringArray tokens;
+    tokens.addTokens(text, ",", "");
+    for (auto& token : tokens) {
+        auto t = token.trim();
+        if (t.isEmpty()) continue;
+        int a = t.upToFirstOccurrenceOf("-", false, false).getIntValue();
+        int b = t.contains("-") ? t.fromFirstOccurrenceOf("-", false, false).getIntValue() : a;
+        if (a > b) std::swap(a, b);
+        for (int i = juce::jmax(a, minVal); i <= juce::jmin(b, maxVal); ++i) result.push_back(i);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void setUpOffline(NextGenKickAudioProcessor& proc, double sampleRate, int blockSize, int preset) {
+    proc.setNonRealtime(true);
+    proc.useStemCache = false;
+    proc.noiseSeed = 1;
+    proc.setPlayConfigDetails(0, 2, sampleRate, blockSize);
+    if (preset >= 0) proc.loadPreset(preset);
+}
+
+void setParameter(NextGenKickAudioProcessor& proc, ParamId id, float value) {
+    if (auto* param = proc.apvts.getParameter(paramSpec(id).id))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+double timeOneShot(NextGenKickAudioProcessor& proc, const Settings& settings, juce::AudioBuffer<float>& block, juce::MidiBuffer& midi,
+    juce::AudioBuffer<float>* output) {
+    const int totalSamples = (int)std::ceil(settings.lengthSeconds * settings.sampleRate);
+    proc.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    for (int pos = 0; pos < totalSamples; pos += settings.blockSize) {
+        const int n = juce::jmin(settings.blockSize, totalSamples - pos);
+        block.setSize(2, n, false, false, true);
+        block.clear();
+        midi.clear();
+        if (pos == 0) midi.addEvent(juce::MidiMessage::noteOn(1, 36, (juce::uint8)127), 0);
+        proc.processBlock(block, midi);
+        if (output != nullptr)
+            for (int ch = 0; ch < 2; ++ch) output->copyFrom(ch, pos, block, ch, 0, n);
+    }
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return seconds * 1.0e9 / (double)totalSamples;
+}
+
+} // namespace RenderHarness
@@ -0,0 +1,35 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include <vector>
+
+// --- Shared harness for the render, check and benchmark modes ---
+// Command-line settings, index lists and the one way every mode sets a processor up offline.
+namespace RenderHarness {
+
+struct Settings {
+    juce::File outDir;
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    double lengthSeconds = 2.0;
+    int bitDepth = 24;
+};
+
+// --rate, --block and --length from the command line, clamped; the defaults are 48 kHz, 512 and `lengthSeconds`
+Settings readSettings(const juce::ArgumentList& args, double lengthSeconds, double minLength = 0.05, double maxLength = 30.0);
+
+// Parses "all", "5", "0,3,10-20" into indices clamped to [minVal, maxVal]
+std::vector<int> parseIndexList(const juce::String& text, int minVal, int maxVal);
+
+// Non-realtime, stereo out at sampleRate / blockSize, every layer synthesized on the audio thread
+// (cached stems arrive on the render thread's schedule, so two renders could differ) and noise from
+// seed 1; then loads `preset` unless it is negative. Modes that need the stem cache turn it on after.
+void setUpOffline(NextGenKickAudioProcessor& proc, double sampleRate, int blockSize, int preset = -1);
+
+void setParameter(NextGenKickAudioProcessor& proc, ParamId id, float value);
+
+// Returns ns per output sample for one note rendered from silence (copied to `output` if given)
+double timeOneShot(NextGenKickAudioProcessor& proc, const Settings& settings, juce::AudioBuffer<float>& block, juce::MidiBuffer& midi,
+    juce::AudioBuffer<float>* output = nullptr);
+
+} // namespace RenderHarness
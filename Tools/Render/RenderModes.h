@@ -0,0 +1,29 @@
+#pragma once
+#include "RenderHarness.h"
+
+// --- Check and benchmark modes ---
+// One translation unit each; main() parses the options and dispatches. Checks print PASS or FAIL and
+// return the exit code, benchmarks print their table and return 0.
+namespace RenderModes {
+
+using namespace RenderHarness;
+
+int checkEnvelopes();
+int checkFastMath();
+int checkNoise();
+int checkWavetables();
+int checkFilters();
+int checkLayerBuses(const Settings& settings, const juce::String& presetList);
+int checkParameterLayout();
+
+int auditRealtime(const Settings& settings, const juce::String& presetList);
+
+int benchKernels(const Settings& settings);
+int benchBlockSizes(const Settings& settings, const juce::String& presetList);
+int benchLimiter(double sampleRate);
+int benchStemCache(const Settings& settings, const juce::String& presetList);
+int benchIdle(const Settings& settings, const juce::String& presetList);
+int benchPresets(const juce::String& presetList, int passes);
+int benchEditor(const Settings& settings);
+
+} // namespace RenderModes